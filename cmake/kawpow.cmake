@@ -4,6 +4,7 @@ if (WITH_KAWPOW)
     list(APPEND HEADERS_CRYPTO
         src/crypto/kawpow/KPCache.h
         src/crypto/kawpow/KPHash.h
+        src/crypto/kawpow/KPMix.h
     )
 
     list(APPEND SOURCES_CRYPTO
@@ -11,6 +12,21 @@ if (WITH_KAWPOW)
         src/crypto/kawpow/KPHash.cpp
     )
 
+    if (WITH_AVX2)
+        list(APPEND SOURCES_CRYPTO
+            src/crypto/kawpow/KPHash_avx2.cpp
+            src/crypto/kawpow/KPHash_avx512.cpp
+        )
+
+        if (CMAKE_CXX_COMPILER_ID MATCHES GNU OR CMAKE_CXX_COMPILER_ID MATCHES Clang)
+            set_source_files_properties(src/crypto/kawpow/KPHash_avx2.cpp PROPERTIES COMPILE_FLAGS "-O3 -mavx2")
+            set_source_files_properties(src/crypto/kawpow/KPHash_avx512.cpp PROPERTIES COMPILE_FLAGS "-O3 -mavx512f")
+        elseif (CMAKE_CXX_COMPILER_ID MATCHES MSVC)
+            set_source_files_properties(src/crypto/kawpow/KPHash_avx2.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+            set_source_files_properties(src/crypto/kawpow/KPHash_avx512.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX512")
+        endif()
+    endif()
+
     add_subdirectory(src/3rdparty/libethash)
     set(ETHASH_LIBRARY ethash)
 else()
@@ -0,0 +1,17 @@
+if (WITH_ZLIB AND WITH_HTTP)
+    find_package(ZLIB)
+
+    if (ZLIB_FOUND)
+        include_directories(${ZLIB_INCLUDE_DIRS})
+        add_definitions(/DXMRIG_FEATURE_ZLIB)
+
+        message("-- WITH_ZLIB=ON")
+    else()
+        set(ZLIB_LIBRARIES "")
+
+        message("-- WITH_ZLIB=OFF (zlib NOT found, HTTP API responses are not compressed)")
+    endif()
+else()
+    set(ZLIB_LIBRARIES "")
+    remove_definitions(/DXMRIG_FEATURE_ZLIB)
+endif()
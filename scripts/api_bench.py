@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+
+# HTTP API load test, measures throughput and CPU time used by the miner per request (Linux only).
+#
+#   api_bench.py --pid $(pidof xmrig) [--url http://127.0.0.1:18080/2/summary] [--requests 20000] [--gzip] [--token TOKEN]
+#
+# Run the miner with the CPU backend disabled to get stable numbers, every request opens a new connection
+# like most monitoring tools do.
+
+import argparse
+import os
+import socket
+import time
+from urllib.parse import urlparse
+
+
+def cpu_time(pid):
+    with open('/proc/{}/stat'.format(pid)) as f:
+        fields = f.read().rsplit(')', 1)[1].split()
+
+    return (int(fields[11]) + int(fields[12])) / os.sysconf('SC_CLK_TCK')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='HTTP API load test')
+    parser.add_argument('--pid', type=int, required=True, help='miner process id')
+    parser.add_argument('--url', default='http://127.0.0.1:18080/2/summary')
+    parser.add_argument('--requests', type=int, default=20000)
+    parser.add_argument('--gzip', action='store_true', help='send Accept-Encoding: gzip')
+    parser.add_argument('--etag', help='send If-None-Match with this value')
+    parser.add_argument('--token', help='access token')
+    args = parser.parse_args()
+
+    url = urlparse(args.url)
+    headers = ['GET {} HTTP/1.1'.format(url.path or '/'), 'Host: {}'.format(url.netloc)]
+
+    if args.gzip:
+        headers.append('Accept-Encoding: gzip')
+
+    if args.etag:
+        headers.append('If-None-Match: {}'.format(args.etag))
+
+    if args.token:
+        headers.append('Authorization: Bearer {}'.format(args.token))
+
+    request = ('\r\n'.join(headers) + '\r\n\r\n').encode()
+    address = (url.hostname, url.port or 80)
+    size = 0
+
+    start_cpu = cpu_time(args.pid)
+    start = time.time()
+
+    for _ in range(args.requests):
+        with socket.create_connection(address) as s:
+            s.sendall(request)
+
+            while True:
+                data = s.recv(65536)
+                if not data:
+                    break
+
+                size += len(data)
+
+    elapsed = time.time() - start
+    used = cpu_time(args.pid) - start_cpu
+
+    print('{} requests, {:.0f} req/s, miner cpu {:.1f} us/req, {:.0f} bytes/response'.format(
+        args.requests, args.requests / elapsed, used * 1e6 / args.requests, size / args.requests))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+
+# Reference server for the binary pool protocol (doc/BINARY.md).
+#
+#   binary_pool.py --self-test             encode/decode round-trip of every message
+#   binary_pool.py [--port 3334] [--diff 1000] [--no-getjob]
+#
+# In server mode every message received from the miner is decoded and encoded again, any difference
+# with the original bytes is reported as a framing error. Jobs are sent split into small chunks to
+# exercise partial reads on the miner side. Shares are accepted without verification.
+
+import argparse
+import os
+import socket
+import struct
+import sys
+import threading
+import time
+
+HEADER_SIZE = 6
+MAX_PAYLOAD = 64 * 1024
+VERSION = 1
+FLAG_GETJOB = 1
+
+SETUP_CONNECTION = 0x00
+SETUP_CONNECTION_SUCCESS = 0x01
+SETUP_CONNECTION_ERROR = 0x02
+NEW_MINING_JOB = 0x15
+SUBMIT_SHARES = 0x1a
+SUBMIT_SHARES_SUCCESS = 0x1c
+SUBMIT_SHARES_ERROR = 0x1d
+GET_JOB = 0x1e
+RECONNECT = 0x25
+PING = 0x7e
+PONG = 0x7f
+
+# Field types: U8, U16, U32, U64, STR (U8 length), B8 (U8 length), B16 (U16 length), ALGOS (U8 count + STR).
+MESSAGES = {
+    SETUP_CONNECTION: ('SetupConnection', [('protocol', 'U8'), ('min', 'U16'), ('max', 'U16'), ('flags', 'U32'), ('agent', 'STR'),
+                                           ('user', 'STR'), ('password', 'STR'), ('rig_id', 'STR'), ('algo', 'ALGOS')]),
+    SETUP_CONNECTION_SUCCESS: ('SetupConnectionSuccess', [('version', 'U16'), ('flags', 'U32'), ('id', 'STR')]),
+    SETUP_CONNECTION_ERROR: ('SetupConnectionError', [('flags', 'U32'), ('error', 'STR')]),
+    NEW_MINING_JOB: ('NewMiningJob', [('job_id', 'STR'), ('algo', 'STR'), ('height', 'U64'), ('target', 'U64'), ('seed', 'B8'), ('blob', 'B16')]),
+    SUBMIT_SHARES: ('SubmitShares', [('sequence', 'U32'), ('job_id', 'STR'), ('nonce', 'U32'), ('result', 'B8'), ('signature', 'B8'), ('algo', 'STR')]),
+    SUBMIT_SHARES_SUCCESS: ('SubmitSharesSuccess', [('sequence', 'U32')]),
+    SUBMIT_SHARES_ERROR: ('SubmitSharesError', [('sequence', 'U32'), ('error', 'STR')]),
+    GET_JOB: ('GetJob', []),
+    RECONNECT: ('Reconnect', [('host', 'STR'), ('port', 'U16')]),
+    PING: ('Ping', []),
+    PONG: ('Pong', []),
+}
+
+INTS = {'U8': '<B', 'U16': '<H', 'U32': '<I', 'U64': '<Q'}
+
+
+class ProtocolError(Exception):
+    pass
+
+
+def encode(msg_type, fields):
+    payload = b''
+
+    for name, kind in MESSAGES[msg_type][1]:
+        value = fields[name]
+
+        if kind in INTS:
+            payload += struct.pack(INTS[kind], value)
+        elif kind in ('STR', 'B8'):
+            data = value.encode() if kind == 'STR' else value
+            payload += struct.pack('<B', len(data)) + data
+        elif kind == 'B16':
+            payload += struct.pack('<H', len(value)) + value
+        elif kind == 'ALGOS':
+            payload += struct.pack('<B', len(value)) + b''.join(struct.pack('<B', len(a)) + a.encode() for a in value)
+
+    return struct.pack('<HB', 0, msg_type) + len(payload).to_bytes(3, 'little') + payload
+
+
+def decode(msg_type, payload):
+    fields = {}
+    offset = 0
+
+    def take(size):
+        nonlocal offset
+        if offset + size > len(payload):
+            raise ProtocolError('truncated {}'.format(MESSAGES[msg_type][0]))
+        data = payload[offset:offset + size]
+        offset += size
+        return data
+
+    for name, kind in MESSAGES[msg_type][1]:
+        if kind in INTS:
+            fields[name] = struct.unpack(INTS[kind], take(struct.calcsize(INTS[kind])))[0]
+        elif kind in ('STR', 'B8'):
+            data = take(take(1)[0])
+            fields[name] = data.decode() if kind == 'STR' else data
+        elif kind == 'B16':
+            fields[name] = take(struct.unpack('<H', take(2))[0])
+        elif kind == 'ALGOS':
+            fields[name] = [take(take(1)[0]).decode() for _ in range(take(1)[0])]
+
+    if offset != len(payload):
+        raise ProtocolError('{} has {} trailing bytes'.format(MESSAGES[msg_type][0], len(payload) - offset))
+
+    return fields
+
+
+def split(buf):
+    """Returns complete (type, payload) frames and the remaining bytes."""
+    frames = []
+
+    while len(buf) >= HEADER_SIZE:
+        size = int.from_bytes(buf[3:6], 'little')
+        if size > MAX_PAYLOAD:
+            raise ProtocolError('message too large: {} bytes'.format(size))
+
+        if len(buf) < HEADER_SIZE + size:
+            break
+
+        if buf[0] == 0 and buf[1] == 0:
+            frames.append((buf[2], buf[HEADER_SIZE:HEADER_SIZE + size]))
+
+        buf = buf[HEADER_SIZE + size:]
+
+    return frames, buf
+
+
+def self_test():
+    samples = {
+        SETUP_CONNECTION: {'protocol': 0, 'min': 1, 'max': 1, 'flags': 0, 'agent': 'XMRig/6', 'user': 'wallet', 'password': 'x',
+                           'rig_id': '', 'algo': ['rx/0', 'cn/r']},
+        SETUP_CONNECTION_SUCCESS: {'version': 1, 'flags': FLAG_GETJOB, 'id': 'id1'},
+        SETUP_CONNECTION_ERROR: {'flags': 0, 'error': 'invalid address'},
+        NEW_MINING_JOB: {'job_id': 'j1', 'algo': 'rx/0', 'height': 3000000, 'target': 0xFFFFFFFFFFFFFFFF // 1000, 'seed': bytes(range(32)),
+                         'blob': bytes(range(76))},
+        SUBMIT_SHARES: {'sequence': 7, 'job_id': 'j1', 'nonce': 0xdeadbeef, 'result': bytes(32), 'signature': b'', 'algo': 'rx/0'},
+        SUBMIT_SHARES_SUCCESS: {'sequence': 7},
+        SUBMIT_SHARES_ERROR: {'sequence': 8, 'error': 'Low difficulty share'},
+        GET_JOB: {},
+        RECONNECT: {'host': '', 'port': 3335},
+        PING: {},
+        PONG: {},
+    }
+
+    stream = b''.join(encode(t, f) for t, f in samples.items())
+
+    # Feed the stream byte by byte, as a worst case of partial reads.
+    frames, buf = [], b''
+    for i in range(len(stream)):
+        done, buf = split(buf + stream[i:i + 1])
+        frames += done
+
+    assert not buf, 'incomplete frame left'
+    assert [t for t, _ in frames] == list(samples), 'message order'
+
+    for msg_type, payload in frames:
+        assert decode(msg_type, payload) == samples[msg_type], MESSAGES[msg_type][0]
+        assert encode(msg_type, decode(msg_type, payload))[HEADER_SIZE:] == payload, MESSAGES[msg_type][0]
+
+    for msg_type, payload in frames:
+        if payload:
+            try:
+                decode(msg_type, payload[:-1])
+                raise AssertionError('truncated {} accepted'.format(MESSAGES[msg_type][0]))
+            except ProtocolError:
+                pass
+
+    print('OK {} messages'.format(len(frames)))
+
+
+class Session:
+    def __init__(self, conn, args):
+        self.conn = conn
+        self.args = args
+        self.jobs = 0
+
+    def log(self, text):
+        print('{:.3f} {}'.format(time.time(), text), flush=True)
+
+    def send(self, msg_type, **fields):
+        data = encode(msg_type, fields)
+        for i in range(0, len(data), 7):
+            self.conn.sendall(data[i:i + 7])
+
+    def job(self):
+        self.jobs += 1
+        blob = bytes([16, 16]) + os.urandom(74)
+        self.send(NEW_MINING_JOB, job_id='job{}'.format(self.jobs), algo=self.args.algo, height=self.jobs, target=0xFFFFFFFFFFFFFFFF // self.args.diff,
+                  seed=bytes(32), blob=blob)
+
+    def on_message(self, msg_type, payload):
+        if msg_type not in MESSAGES:
+            raise ProtocolError('unknown message type 0x{:02x}'.format(msg_type))
+
+        fields = decode(msg_type, payload)
+        if encode(msg_type, fields)[HEADER_SIZE:] != payload:
+            raise ProtocolError('{} does not round-trip'.format(MESSAGES[msg_type][0]))
+
+        self.log('{} {}'.format(MESSAGES[msg_type][0], {k: (v.hex() if isinstance(v, bytes) else v) for k, v in fields.items()}))
+
+        if msg_type == SETUP_CONNECTION:
+            self.send(SETUP_CONNECTION_SUCCESS, version=VERSION, flags=0 if self.args.no_getjob else FLAG_GETJOB, id='miner1')
+            self.job()
+        elif msg_type == SUBMIT_SHARES:
+            if len(fields['result']) != 32 or len(fields['signature']) not in (0, 64):
+                self.send(SUBMIT_SHARES_ERROR, sequence=fields['sequence'], error='Malformed share')
+            else:
+                self.send(SUBMIT_SHARES_SUCCESS, sequence=fields['sequence'])
+        elif msg_type == GET_JOB:
+            self.job()
+        elif msg_type == PING:
+            self.send(PONG)
+
+    def run(self):
+        buf = b''
+        try:
+            while True:
+                data = self.conn.recv(4096)
+                if not data:
+                    break
+
+                frames, buf = split(buf + data)
+                for msg_type, payload in frames:
+                    self.on_message(msg_type, payload)
+        except (ProtocolError, OSError) as e:
+            self.log('error: {}'.format(e))
+        finally:
+            self.conn.close()
+            self.log('closed')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Binary pool protocol reference server')
+    parser.add_argument('--self-test', action='store_true')
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=3334)
+    parser.add_argument('--diff', type=int, default=1000)
+    parser.add_argument('--algo', default='rx/0')
+    parser.add_argument('--no-getjob', action='store_true')
+    args = parser.parse_args()
+
+    if args.self_test:
+        return self_test()
+
+    server = socket.socket()
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind((args.host, args.port))
+    server.listen(8)
+
+    while True:
+        conn, _ = server.accept()
+        threading.Thread(target=Session(conn, args).run, daemon=True).start()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -41,7 +41,8 @@
 #include "version.h"
 
 
-xmrig::App::App(Process *process)
+xmrig::App::App(Process *process) :
+    m_process(process)
 {
     m_controller = std::make_shared<Controller>(process);
 }
@@ -90,6 +91,13 @@ int xmrig::App::exec()
     rc = uv_run(uv_default_loop(), UV_RUN_DEFAULT);
     uv_loop_close(uv_default_loop());
 
+#   ifdef SIGUSR2
+    // Replace the process image only after the event loop is drained, so pending log writes and connection closes are done.
+    if (m_upgrade) {
+        return reexec();
+    }
+#   endif
+
     return rc;
 }
 
@@ -115,6 +123,11 @@ void xmrig::App::onSignal(int signum)
     case SIGINT:
         return close();
 
+#   ifdef SIGUSR2
+    case SIGUSR2:
+        return upgrade();
+#   endif
+
     default:
         break;
     }
@@ -61,11 +61,15 @@ protected:
 
 private:
     bool background(int &rc);
+    int reexec();
     void close();
+    void upgrade();
 
     std::shared_ptr<Console> m_console;
     std::shared_ptr<Controller> m_controller;
     std::shared_ptr<Signals> m_signals;
+    bool m_upgrade = false;
+    Process *m_process;
 };
 
 
@@ -26,16 +26,64 @@
 #include <cstdlib>
 #include <csignal>
 #include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
 #include <unistd.h>
 
 
 #include "App.h"
 #include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Process.h"
 #include "core/Controller.h"
+#include "core/Miner.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/Rx.h"
+#   include "crypto/rx/RxHandover.h"
+#endif
+
+
+namespace xmrig {
+
+
+static const char *kUpgradeEnv = "XMRIG_UPGRADE";
+static std::string workDir;
+
+
+static std::string exePath()
+{
+    // If the binary was replaced on disk, the kernel reports the old image as "<path> (deleted)".
+    std::string path = Process::exepath().data();
+    const std::string deleted = " (deleted)";
+
+    if (path.size() > deleted.size() && path.compare(path.size() - deleted.size(), deleted.size(), deleted) == 0) {
+        path.resize(path.size() - deleted.size());
+    }
+
+    return path;
+}
+
+
+} // namespace xmrig
 
 
 bool xmrig::App::background(int &rc)
 {
+    // The process was already detached before it replaced itself with a new image.
+    if (getenv(kUpgradeEnv)) {
+        unsetenv(kUpgradeEnv);
+
+        if (m_controller->isBackground() && chdir("/") < 0) {
+            LOG_ERR("chdir() failed (errno = %d)", errno);
+        }
+
+        return false;
+    }
+
     if (!m_controller->isBackground()) {
         return false;
     }
@@ -59,6 +107,12 @@ bool xmrig::App::background(int &rc)
         LOG_ERR("setsid() failed (errno = %d)", errno);
     }
 
+    // Relative paths in the command line must be resolved the same way after an upgrade.
+    char buf[4096]{};
+    if (getcwd(buf, sizeof(buf))) {
+        workDir = buf;
+    }
+
     i = chdir("/");
     if (i < 0) {
         LOG_ERR("chdir() failed (errno = %d)", errno);
@@ -66,3 +120,59 @@ bool xmrig::App::background(int &rc)
 
     return false;
 }
+
+
+void xmrig::App::upgrade()
+{
+    const std::string path = exePath();
+    if (path.empty() || access(path.c_str(), X_OK) != 0) {
+        LOG_ERR("%s " RED("upgrade failed, \"%s\" is not executable"), Tags::signal(), path.c_str());
+
+        return;
+    }
+
+    bool dataset = false;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    // Mining threads must be stopped first, the dataset memory is released while it is copied out.
+    m_controller->miner()->stop();
+    dataset = Rx::handover();
+#   endif
+
+    LOG_NOTICE("%s " WHITE_BOLD("exec ") CYAN_BOLD("%s") WHITE_BOLD(", RandomX dataset ") "%s", Tags::signal(), path.c_str(), dataset ? GREEN_BOLD("passed") : YELLOW_BOLD("not passed"));
+
+    m_upgrade = true;
+
+    close();
+}
+
+
+int xmrig::App::reexec()
+{
+    const std::string path = exePath();
+
+    if (!workDir.empty() && chdir(workDir.c_str()) < 0) {
+        fprintf(stderr, "[upgrade] chdir \"%s\" failed: %s\n", workDir.c_str(), strerror(errno));
+    }
+
+    // libuv reopens terminal descriptors with close-on-exec, standard streams must stay open in the new image.
+    for (int fd = STDIN_FILENO; fd <= STDERR_FILENO; ++fd) {
+        const int flags = fcntl(fd, F_GETFD);
+        if (flags >= 0) {
+            fcntl(fd, F_SETFD, flags & ~FD_CLOEXEC);
+        }
+    }
+
+    setenv(kUpgradeEnv, "1", 1);
+    execv(path.c_str(), m_process->arguments().argv());
+
+    fprintf(stderr, "[upgrade] execv \"%s\" failed: %s\n", path.c_str(), strerror(errno));
+
+    unsetenv(kUpgradeEnv);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    RxHandover::release();
+#   endif
+
+    return 1;
+}
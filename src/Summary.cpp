@@ -18,10 +18,12 @@
 
 #include <cinttypes>
 #include <cstdio>
+#include <string>
 #include <uv.h>
 
 
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/platform/CoreRanking.h"
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Pool.h"
 #include "core/config/Config.h"
@@ -108,9 +110,29 @@ static void print_cpu(const Config *)
                info->threads(),
                info->nodes()
                );
+
+    const auto &ranking = info->ranking();
+    if (ranking.isValid()) {
+        const auto preferred = ranking.preferred();
+        std::string cpus;
+
+        for (size_t i = 0; i < preferred.size() && i < 16; ++i) {
+            cpus += (i ? "," : "") + std::to_string(preferred[i]);
+        }
+
+        Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("preferred:") CYAN_BOLD("%s%s") BLACK_BOLD(" (%s, %zu levels)"),
+                   "",
+                   cpus.c_str(),
+                   preferred.size() > 16 ? ",..." : "",
+                   ranking.sourceName(),
+                   ranking.levels()
+                   );
+    }
 #   else
     Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("threads:") CYAN_BOLD("%zu"), "", info->threads());
 #   endif
+
+    Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("uarch:") WHITE_BOLD("%s") BLACK_BOLD(" (profiles v%u)"), "", info->profile().name, static_cast<uint32_t>(CpuProfile::kVersion));
 }
 
 
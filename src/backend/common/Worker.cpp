@@ -22,12 +22,37 @@
 #include "crypto/common/VirtualMemory.h"
 
 
+#include <new>
+
+
 xmrig::Worker::Worker(size_t id, int64_t affinity, int priority) :
     m_affinity(affinity),
-    m_id(id)
+    m_id(id),
+    m_node(VirtualMemory::nodeOf(affinity))
+{
+    Platform::setThreadPriority(priority);
+}
+
+
+void *xmrig::Worker::operator new(size_t size)
+{
+    void *p = VirtualMemory::allocateLocalMemory(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+
+void xmrig::Worker::operator delete(void *p, size_t size)
 {
-    m_node = VirtualMemory::bindToNUMANode(affinity);
+    VirtualMemory::freeLargePagesMemory(p, size);
+}
+
 
+void xmrig::Worker::bind(int64_t affinity)
+{
+    VirtualMemory::bindToNUMANode(affinity);
     Platform::trySetThreadAffinity(affinity);
-    Platform::setThreadPriority(priority);
 }
@@ -31,7 +31,15 @@ class Worker : public IWorker
 public:
     Worker(size_t id, int64_t affinity, int priority);
 
+    // Workers are created on their own thread after bind(), fresh pages keep the object on the thread's NUMA node.
+    static void *operator new(size_t size);
+    static void operator delete(void *p, size_t size);
+
+    static void bind(int64_t affinity);
+
+    size_t remoteMemory() const override                    { return 0; }
     size_t threads() const override                         { return 1; }
+    void canaryData(uint64_t &checks, uint64_t &errors, bool &quarantined) const override { checks = 0; errors = 0; quarantined = false; }
 
 protected:
     inline int64_t affinity() const                         { return m_affinity; }
@@ -43,7 +51,7 @@ protected:
 private:
     const int64_t m_affinity;
     const size_t m_id;
-    uint32_t m_node                 = 0;
+    const uint32_t m_node;
 };
 
 
@@ -22,6 +22,7 @@
 #include "backend/cpu/CpuWorker.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
 #include "base/tools/Chrono.h"
 
 
@@ -177,6 +178,12 @@ void *xmrig::Workers<T>::onReady(void *arg)
 {
     auto handle = static_cast<Thread<T>* >(arg);
 
+    // Workers are started from the event loop thread, don't keep its timer slack.
+    Platform::setThreadSchedProfile(Platform::SCHED_PROFILE_DEFAULT);
+
+    // Pin the thread and bind its memory before anything is allocated for the worker, the worker object included.
+    Worker::bind(handle->config().affinity);
+
     IWorker *worker = create(handle);
     assert(worker != nullptr);
 
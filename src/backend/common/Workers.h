@@ -54,6 +54,7 @@ public:
     Workers();
     ~Workers();
 
+    inline IWorker *worker(size_t index) const      { return index < m_workers.size() ? m_workers[index]->worker() : nullptr; }
     inline void start(const std::vector<T> &data)   { start(data, true); }
 
     bool tick(uint64_t ticks);
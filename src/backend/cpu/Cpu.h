@@ -21,6 +21,7 @@
 
 
 #include "backend/cpu/interfaces/ICpuInfo.h"
+#include "backend/cpu/platform/CpuProfile.h"
 
 
 namespace xmrig {
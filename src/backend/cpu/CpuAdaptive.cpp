@@ -0,0 +1,325 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/CpuAdaptive.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+
+
+#ifdef XMRIG_FEATURE_HWLOC
+#   include <hwloc.h>
+
+#   if HWLOC_API_VERSION < 0x20000
+static inline int hwloc_obj_type_is_cache(hwloc_obj_type_t type)
+{
+    return type == HWLOC_OBJ_CACHE;
+}
+#   endif
+#endif
+
+
+namespace xmrig {
+
+
+static constexpr double kMinGain        = 0.03;
+static constexpr uint64_t kHoldRounds   = 10;
+static constexpr uint64_t kWarmup       = 10000;
+
+
+static int64_t l3Of(int64_t affinity)
+{
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (affinity < 0) {
+        return -1;
+    }
+
+    auto topology = Cpu::info()->topology();
+
+    for (auto obj = hwloc_get_pu_obj_by_os_index(topology, static_cast<unsigned>(affinity)); obj != nullptr; obj = obj->parent) {
+        if (hwloc_obj_type_is_cache(obj->type) && obj->attr->cache.depth == 3) {
+            return obj->logical_index;
+        }
+    }
+#   endif
+
+    return -1;
+}
+
+
+static std::string describe(const std::vector<CpuThread> &threads)
+{
+    uint32_t min = 8;
+    uint32_t max = 0;
+
+    for (const auto &thread : threads) {
+        min = std::min(min, thread.intensity());
+        max = std::max(max, thread.intensity());
+    }
+
+    char buf[64] = {};
+
+    if (min == max) {
+        snprintf(buf, sizeof(buf), "%zu threads intensity %u", threads.size(), max);
+    }
+    else {
+        snprintf(buf, sizeof(buf), "%zu threads intensity %u-%u", threads.size(), min, max);
+    }
+
+    return buf;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::CpuAdaptive::tick(uint64_t now, const Hashrate *hashrate, bool active)
+{
+    if (m_state == STATE_DISABLED || !hashrate || now < m_due) {
+        return false;
+    }
+
+    const double rate = hashrate->calc(m_trial);
+
+    // A paused miner or a window where not every thread has reported says nothing about the layout, wait for a clean window.
+    if (!active || rate <= 0.0) {
+        m_due = now + kWarmup + m_trial;
+
+        return false;
+    }
+
+    if (m_state == STATE_MEASURE) {
+        LOG_INFO("%s adaptive " WHITE_BOLD("%s") " " CYAN_BOLD("%.1f H/s"), Tags::cpu(), describe(m_current).c_str(), rate);
+
+        m_tried.assign(1, m_current);
+        measure(hashrate, rate);
+
+        return next(now);
+    }
+
+    const double gain = (rate / m_rate - 1.0) * 100.0;
+
+    if (rate > m_rate * (1.0 + kMinGain)) {
+        LOG_INFO("%s adaptive " GREEN_BOLD("keep") " %s " CYAN_BOLD("%.1f H/s") GREEN(" +%.1f%%"), Tags::cpu(), describe(m_current).c_str(), rate, gain);
+
+        m_accepted = m_current;
+        measure(hashrate, rate);
+    }
+    else {
+        LOG_INFO("%s adaptive " YELLOW("drop") " %s " CYAN_BOLD("%.1f H/s") BLACK_BOLD(" (%+.1f%%)"), Tags::cpu(), describe(m_current).c_str(), rate, gain);
+    }
+
+    return next(now);
+}
+
+
+const std::vector<xmrig::CpuThread> &xmrig::CpuAdaptive::select(const Algorithm &algorithm, std::vector<CpuThread> &&threads, uint32_t trial)
+{
+    if (trial == 0 || threads.empty()) {
+        m_state   = STATE_DISABLED;
+        m_current = std::move(threads);
+
+        return m_current;
+    }
+
+    // Intensity 0 in the config means 1, keep it explicit so generated layouts compare equal to the configured one.
+    for (auto &thread : threads) {
+        thread = CpuThread(thread.affinity(), thread.intensity());
+    }
+
+    if (m_state != STATE_DISABLED && algorithm == m_algorithm && threads == m_base && m_trial == trial * 1000ULL) {
+        return m_current;
+    }
+
+    m_algorithm = algorithm;
+    m_base      = std::move(threads);
+    m_current   = m_base;
+    m_accepted  = m_base;
+    m_rate      = 0.0;
+    m_state     = STATE_MEASURE;
+    m_trial     = trial * 1000ULL;
+    m_due       = Chrono::steadyMSecs() + kWarmup + m_trial;
+
+    m_candidates.clear();
+    m_tried.clear();
+
+    return m_current;
+}
+
+
+rapidjson::Value xmrig::CpuAdaptive::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (m_state == STATE_DISABLED) {
+        return Value(false);
+    }
+
+    uint32_t intensity = 0;
+    for (const auto &thread : m_accepted) {
+        intensity = std::max(intensity, thread.intensity());
+    }
+
+    Value out(kObjectType);
+    out.AddMember("state",      StringRef(m_state == STATE_TRIAL ? "trial" : "measure"), allocator);
+    out.AddMember("threads",    static_cast<uint64_t>(m_accepted.size()), allocator);
+    out.AddMember("intensity",  intensity, allocator);
+    out.AddMember("hashrate",   Hashrate::normalize(m_rate), allocator);
+
+    return out;
+}
+
+
+bool xmrig::CpuAdaptive::next(uint64_t now)
+{
+    m_candidates = neighbours();
+
+    if (!m_candidates.empty()) {
+        m_current = std::move(m_candidates.front());
+        m_state   = STATE_TRIAL;
+        m_due     = now + kWarmup + m_trial;
+
+        m_tried.emplace_back(m_current);
+
+        LOG_INFO("%s adaptive " MAGENTA_BOLD("trial") " %s", Tags::cpu(), describe(m_current).c_str());
+
+        return true;
+    }
+
+    const bool changed = m_current != m_accepted;
+
+    m_current = m_accepted;
+    m_state   = STATE_MEASURE;
+    m_due     = now + kHoldRounds * (kWarmup + m_trial);
+
+    return changed;
+}
+
+
+std::vector<std::vector<xmrig::CpuThread> > xmrig::CpuAdaptive::neighbours() const
+{
+    std::vector<std::vector<CpuThread> > out;
+
+    auto add = [this, &out](std::vector<CpuThread> &&threads) {
+        if (!threads.empty() && std::find(m_tried.begin(), m_tried.end(), threads) == m_tried.end()) {
+            out.emplace_back(std::move(threads));
+        }
+    };
+
+    auto cap = [this](const CpuThread &thread) {
+        const auto it = std::find_if(m_base.begin(), m_base.end(), [&thread](const CpuThread &base) { return base.affinity() == thread.affinity(); });
+
+        return it != m_base.end() ? it->intensity() : thread.intensity();
+    };
+
+    std::vector<CpuThread> lower;
+    std::vector<CpuThread> higher;
+
+    for (const auto &thread : m_accepted) {
+        lower.emplace_back(thread.affinity(),  thread.intensity() > m_algorithm.minIntensity() ? thread.intensity() - 1 : thread.intensity());
+        higher.emplace_back(thread.affinity(), std::min(thread.intensity() + 1, cap(thread)));
+    }
+
+    if (lower != m_accepted) {
+        add(std::move(lower));
+    }
+
+    // One thread fewer per L3 domain, the slowest thread of each shared domain is dropped.
+    std::map<int64_t, size_t> count;
+    std::map<int64_t, size_t> slowest;
+
+    for (size_t i = 0; i < m_accepted.size(); ++i) {
+        const int64_t l3 = l3Of(m_accepted[i].affinity());
+        const auto it    = slowest.find(l3);
+
+        count[l3]++;
+
+        if (it == slowest.end() || m_threadRates[i] < m_threadRates[it->second]) {
+            slowest[l3] = i;
+        }
+    }
+
+    std::vector<CpuThread> fewer;
+
+    for (size_t i = 0; i < m_accepted.size(); ++i) {
+        const int64_t l3 = l3Of(m_accepted[i].affinity());
+
+        if (count[l3] < 2 || slowest[l3] != i) {
+            fewer.emplace_back(m_accepted[i]);
+        }
+    }
+
+    if (fewer.size() < m_accepted.size()) {
+        add(std::move(fewer));
+    }
+
+    // The way back to the configured layout, in case the neighbours have gone quiet.
+    if (higher != m_accepted) {
+        add(std::move(higher));
+    }
+
+    std::multiset<int64_t> used;
+    for (const auto &thread : m_accepted) {
+        used.insert(thread.affinity());
+    }
+
+    std::set<int64_t> domains;
+    std::vector<CpuThread> more = m_accepted;
+
+    for (const auto &thread : m_base) {
+        const auto it = used.find(thread.affinity());
+        if (it != used.end()) {
+            used.erase(it);
+        }
+        else if (domains.insert(l3Of(thread.affinity())).second) {
+            more.emplace_back(thread.affinity(), std::min(thread.intensity(), m_accepted.front().intensity()));
+        }
+    }
+
+    if (more.size() > m_accepted.size()) {
+        add(std::move(more));
+    }
+
+    return out;
+}
+
+
+void xmrig::CpuAdaptive::measure(const Hashrate *hashrate, double rate)
+{
+    m_rate = rate;
+    m_threadRates.assign(m_current.size(), 0.0);
+
+    for (size_t i = 0; i < m_current.size(); ++i) {
+        const double value = hashrate->calc(i, m_trial);
+
+        m_threadRates[i] = std::isnormal(value) ? value : 0.0;
+    }
+}
@@ -0,0 +1,82 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CPUADAPTIVE_H
+#define XMRIG_CPUADAPTIVE_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/cpu/CpuThread.h"
+#include "base/crypto/Algorithm.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Hashrate;
+
+
+/**
+ * Runtime hill climbing over the CPU thread layout for hosts shared with noisy neighbours.
+ *
+ * The configured layout is measured first, then neighbouring layouts are tried one at a time:
+ * intensity one lower, one thread fewer per L3 domain (the slowest one), and the way back to the
+ * configured layout. A layout is kept only if it beats the current one by kMinGain, after a full
+ * round the controller holds for several rounds before it measures again.
+ * Only the worker threads are restarted, the RandomX dataset and the pool connection are kept.
+ */
+class CpuAdaptive
+{
+public:
+    bool tick(uint64_t now, const Hashrate *hashrate, bool active);
+    const std::vector<CpuThread> &select(const Algorithm &algorithm, std::vector<CpuThread> &&threads, uint32_t trial);
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+
+private:
+    enum State {
+        STATE_DISABLED,
+        STATE_MEASURE,
+        STATE_TRIAL
+    };
+
+    bool next(uint64_t now);
+    std::vector<std::vector<CpuThread> > neighbours() const;
+    void measure(const Hashrate *hashrate, double rate);
+
+    Algorithm m_algorithm;
+    double m_rate       = 0.0;
+    State m_state       = STATE_DISABLED;
+    std::vector<CpuThread> m_accepted;
+    std::vector<CpuThread> m_base;
+    std::vector<CpuThread> m_current;
+    std::vector<double> m_threadRates;
+    std::vector<std::vector<CpuThread> > m_candidates;
+    std::vector<std::vector<CpuThread> > m_tried;
+    uint64_t m_due      = 0;
+    uint64_t m_trial    = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUADAPTIVE_H */
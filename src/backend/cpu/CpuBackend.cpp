@@ -26,13 +26,18 @@
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuAdaptive.h"
+#include "backend/cpu/platform/Cgroup.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/io/Watcher.h"
+#include "base/kernel/interfaces/IWatcherListener.h"
 #include "base/net/stratum/Job.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -48,6 +53,11 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxTuner.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
@@ -62,6 +72,7 @@ extern template class Threads<CpuThreads>;
 
 static const String kType   = "cpu";
 static std::mutex mutex;
+static constexpr uint64_t kCgroupTicks = 20;
 
 
 struct CpuLaunchStatus
@@ -136,12 +147,43 @@ private:
 };
 
 
-class CpuBackendPrivate
+class CpuBackendPrivate : public IWatcherListener
 {
 public:
     inline explicit CpuBackendPrivate(Controller *controller) : controller(controller)   {}
 
 
+    inline void onFileChanged(const String &) override  { cgroupChanged = true; }
+
+
+    bool updateCgroup()
+    {
+        cgroupConfig       = controller->config()->cpu().cgroup();
+        auto next          = Cgroup::read(cgroupConfig);
+        const bool changed = next != cgroup;
+
+        cgroup        = std::move(next);
+        cgroupChanged = false;
+        cgroupReady   = true;
+
+        if (!changed) {
+            return false;
+        }
+
+        watchers.clear();
+
+        if (cgroup.isValid()) {
+            watchers.emplace_back(std::make_shared<Watcher>(String((cgroup.path().data() + std::string("/cpu.max")).c_str()), this));
+            watchers.emplace_back(std::make_shared<Watcher>(String((cgroup.path().data() + std::string("/cpuset.cpus.effective")).c_str()), this));
+
+            LOG_INFO("%s cgroup " WHITE_BOLD("%s") " quota " CYAN_BOLD("%.2f") " cpus " CYAN_BOLD("%zu") " max threads " CYAN_BOLD("%u"),
+                     Tags::cpu(), cgroup.path().data(), cgroup.quota(), cgroup.cpus().size(), cgroup.limit());
+        }
+
+        return true;
+    }
+
+
     inline void start()
     {
         LOG_INFO("%s use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
@@ -170,7 +212,7 @@ public:
     }
 
 
-    rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
+    HugePagesInfo hugePages() const
     {
         HugePagesInfo pages;
 
@@ -186,6 +228,13 @@ public:
 
         mutex.unlock();
 
+        return pages;
+    }
+
+
+    rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
+    {
+        const HugePagesInfo pages = hugePages();
         rapidjson::Value hugepages;
 
         if (version > 1) {
@@ -202,8 +251,14 @@ public:
 
 
     Algorithm algo;
+    bool cgroupChanged  = false;
+    bool cgroupReady    = false;
+    Cgroup cgroup;
+    String cgroupConfig;
     Controller *controller;
+    CpuAdaptive adaptive;
     CpuLaunchStatus status;
+    std::vector<std::shared_ptr<Watcher> > watchers;
     std::vector<CpuLaunchData> threads;
     String profileName;
     Workers<CpuLaunchData> workers;
@@ -268,6 +323,23 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+    // Effective cpuset changes made by a parent cgroup produce no file events, so also poll it periodically.
+    if (isEnabled() && d_ptr->cgroup.isValid() && (d_ptr->cgroupChanged || (ticks % kCgroupTicks) == 0) && d_ptr->updateCgroup()) {
+        const Job job = d_ptr->controller->miner()->job();
+        if (job.isValid()) {
+            LOG_INFO("%s " YELLOW_BOLD("cgroup limits changed, reflow threads"), Tags::cpu());
+
+            setJob(job);
+        }
+    }
+
+    if (isEnabled() && d_ptr->adaptive.tick(Chrono::steadyMSecs(), hashrate(), d_ptr->controller->miner()->isEnabled())) {
+        const Job job = d_ptr->controller->miner()->job();
+        if (job.isValid()) {
+            setJob(job);
+        }
+    }
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -278,6 +350,12 @@ const xmrig::Hashrate *xmrig::CpuBackend::hashrate() const
 }
 
 
+xmrig::HugePagesInfo xmrig::CpuBackend::hugePages() const
+{
+    return d_ptr->hugePages();
+}
+
+
 const xmrig::String &xmrig::CpuBackend::profileName() const
 {
     return d_ptr->profileName;
@@ -351,7 +429,21 @@ void xmrig::CpuBackend::setJob(const Job &job)
 
     const auto &cpu = d_ptr->controller->config()->cpu();
 
-    auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
+    // Later changes of the cgroup limits are picked up by tick(), here only the first read and a changed "cgroup" option.
+    if (!d_ptr->cgroupReady || cpu.cgroup() != d_ptr->cgroupConfig) {
+        d_ptr->updateCgroup();
+    }
+
+    uint32_t adaptive = cpu.adaptive();
+
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    if (BenchState::size()) {
+        adaptive = 0;
+    }
+#   endif
+
+    const auto &fitted = d_ptr->adaptive.select(job.algorithm(), cpu.fit(job.algorithm(), d_ptr->cgroup), adaptive);
+    auto threads       = cpu.get(d_ptr->controller->miner(), job.algorithm(), fitted);
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
     }
@@ -424,6 +516,12 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("hw-aes",     cpu.isHwAES(), allocator);
     out.AddMember("priority",   cpu.priority(), allocator);
     out.AddMember("msr",        Rx::isMSR(), allocator);
+    out.AddMember("cgroup",     d_ptr->cgroup.toJSON(doc), allocator);
+    out.AddMember("adaptive",   d_ptr->adaptive.toJSON(doc), allocator);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    out.AddMember("randomx-tune", RxTuner::toJSON(doc), allocator);
+#   endif
 
 #   ifdef XMRIG_FEATURE_ASM
     const Assembly assembly = Cpu::assembly(cpu.assembly());
@@ -455,6 +553,24 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
 
+        const IWorker *worker = d_ptr->workers.worker(i);
+        thread.AddMember("node",        VirtualMemory::nodeOf(data.affinity), allocator);
+        thread.AddMember("remote_memory", static_cast<uint64_t>(worker ? worker->remoteMemory() : 0), allocator);
+
+        uint64_t checks  = 0;
+        uint64_t errors  = 0;
+        bool quarantined = false;
+
+        if (worker) {
+            worker->canaryData(checks, errors, quarantined);
+        }
+
+        Value canary(kObjectType);
+        canary.AddMember("checks",      checks, allocator);
+        canary.AddMember("errors",      errors, allocator);
+        canary.AddMember("quarantined", quarantined, allocator);
+        thread.AddMember("canary",      canary, allocator);
+
         i++;
         threads.PushBack(thread, allocator);
     }
@@ -22,6 +22,7 @@
 
 #include "backend/common/interfaces/IBackend.h"
 #include "base/tools/Object.h"
+#include "crypto/common/HugePagesInfo.h"
 
 
 #include <utility>
@@ -43,6 +44,8 @@ public:
     CpuBackend(Controller *controller);
     ~CpuBackend() override;
 
+    HugePagesInfo hugePages() const;
+
 protected:
     inline void execCommand(char) override {}
 
@@ -21,20 +21,29 @@
 #include "backend/cpu/CpuConfig_gen.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 
 #include <algorithm>
+#include <iterator>
 
 
 namespace xmrig {
 
+const char *CpuConfig::kAdaptive            = "adaptive";
+const char *CpuConfig::kCanary              = "canary";
+const char *CpuConfig::kCgroup              = "cgroup";
+const char *CpuConfig::kCpuset              = "cpuset";
 const char *CpuConfig::kEnabled             = "enabled";
 const char *CpuConfig::kField               = "cpu";
 const char *CpuConfig::kHugePages           = "huge-pages";
+const char *CpuConfig::kHugePagesDropCaches = "huge-pages-drop-caches";
 const char *CpuConfig::kHugePagesJit        = "huge-pages-jit";
 const char *CpuConfig::kHwAes               = "hw-aes";
 const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
 const char *CpuConfig::kPriority            = "priority";
+const char *CpuConfig::kSchedBatch          = "sched-batch";
 const char *CpuConfig::kYield               = "yield";
 
 #ifdef XMRIG_FEATURE_ASM
@@ -67,10 +76,16 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kEnabled),      m_enabled, allocator);
     obj.AddMember(StringRef(kHugePages),    m_hugePageSize == 0 || m_hugePageSize == kDefaultHugePageSizeKb ? Value(isHugePages()) : Value(static_cast<uint32_t>(m_hugePageSize)), allocator);
     obj.AddMember(StringRef(kHugePagesJit), m_hugePagesJit, allocator);
+    obj.AddMember(StringRef(kHugePagesDropCaches), m_dropCaches, allocator);
     obj.AddMember(StringRef(kHwAes),        m_aes == AES_AUTO ? Value(kNullType) : Value(m_aes == AES_HW), allocator);
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kSchedBatch),   m_schedBatch, allocator);
+    obj.AddMember(StringRef(kCgroup),       m_cgroup == Cgroup::kDefaultRoot || m_cgroup.isNull() ? Value(!m_cgroup.isNull()) : m_cgroup.toJSON(doc), allocator);
+    obj.AddMember(StringRef(kCpuset),       m_cpuset.toJSON(doc), allocator);
+    obj.AddMember(StringRef(kAdaptive),     m_adaptive == 0 ? Value(false) : Value(m_adaptive), allocator);
+    obj.AddMember(StringRef(kCanary),       m_canary == 0 ? Value(false) : Value(m_canary), allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -96,30 +111,26 @@ size_t xmrig::CpuConfig::memPoolSize() const
 }
 
 
-std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm) const
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm, const Cgroup &cgroup) const
 {
-    if (algorithm.family() == Algorithm::KAWPOW) {
-        return {};
-    }
-
-    std::vector<CpuLaunchData> out;
-    const auto &threads = m_threads.get(algorithm);
+    return get(miner, algorithm, fit(algorithm, cgroup));
+}
 
-    if (threads.isEmpty()) {
-        return out;
-    }
 
-    const size_t count = threads.count();
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm, const std::vector<CpuThread> &threads) const
+{
+    std::vector<CpuLaunchData> out;
+    const size_t count = threads.size();
     out.reserve(count);
 
     std::vector<int64_t> affinities;
     affinities.reserve(count);
 
-    for (const auto& thread : threads.data()) {
+    for (const auto& thread : threads) {
         affinities.emplace_back(thread.affinity());
     }
 
-    for (const auto &thread : threads.data()) {
+    for (const auto &thread : threads) {
         out.emplace_back(miner, algorithm, *this, thread, count, affinities);
     }
 
@@ -127,18 +138,58 @@ std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, cons
 }
 
 
+std::vector<xmrig::CpuThread> xmrig::CpuConfig::fit(const Algorithm &algorithm, const Cgroup &cgroup) const
+{
+    if (algorithm.family() == Algorithm::KAWPOW) {
+        return {};
+    }
+
+    const auto &threads = m_threads.get(algorithm);
+
+    if (threads.isEmpty()) {
+        return {};
+    }
+
+    if (m_cpus.empty()) {
+        return cgroup.fit(threads.data());
+    }
+
+    // The kernel keeps unpinned threads inside the cgroup cpuset, but not inside the user one, so they are pinned to it as well.
+    std::set<int64_t> cpus;
+
+    if (cgroup.isValid() && !cgroup.cpus().empty()) {
+        std::set_intersection(m_cpus.begin(), m_cpus.end(), cgroup.cpus().begin(), cgroup.cpus().end(), std::inserter(cpus, cpus.end()));
+
+        if (cpus.empty()) {
+            return {};
+        }
+    }
+    else {
+        cpus = m_cpus;
+    }
+
+    return Cgroup::fit(threads.data(), cpus, cgroup.isValid() ? cgroup.limit() : 0, true);
+}
+
+
 void xmrig::CpuConfig::read(const rapidjson::Value &value)
 {
     if (value.IsObject()) {
         m_enabled      = Json::getBool(value, kEnabled, m_enabled);
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
+        m_dropCaches   = Json::getBool(value, kHugePagesDropCaches, m_dropCaches);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_schedBatch   = Json::getBool(value, kSchedBatch, m_schedBatch);
 
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
         setMemoryPool(Json::getValue(value, kMemoryPool));
         setPriority(Json::getInt(value,  kPriority, -1));
+        setAdaptive(Json::getValue(value, kAdaptive));
+        setCanary(Json::getValue(value, kCanary));
+        setCgroup(Json::getValue(value, kCgroup));
+        setCpuset(Json::getString(value, kCpuset));
 
 #       ifdef XMRIG_FEATURE_ASM
         m_assembly = Json::getValue(value, kAsm);
@@ -184,6 +235,50 @@ void xmrig::CpuConfig::generate()
 }
 
 
+void xmrig::CpuConfig::setAdaptive(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_adaptive = value.GetBool() ? kDefaultAdaptiveTrial : 0U;
+    }
+    else if (value.IsUint()) {
+        m_adaptive = value.GetUint();
+    }
+}
+
+
+void xmrig::CpuConfig::setCanary(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_canary = value.GetBool() ? kDefaultCanary : 0U;
+    }
+    else if (value.IsUint()) {
+        m_canary = value.GetUint();
+    }
+}
+
+
+void xmrig::CpuConfig::setCgroup(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_cgroup = value.GetBool() ? Cgroup::kDefaultRoot : nullptr;
+    }
+    else if (value.IsString()) {
+        m_cgroup = value.GetString();
+    }
+}
+
+
+void xmrig::CpuConfig::setCpuset(const char *cpuset)
+{
+    m_cpuset = cpuset;
+    m_cpus   = Cgroup::parseCpus(cpuset);
+
+    if (!m_cpuset.isEmpty() && m_cpus.empty()) {
+        LOG_WARN("%s " YELLOW("invalid cpuset ") YELLOW_BOLD("\"%s\"") YELLOW(", all CPUs are used"), Tags::cpu(), cpuset);
+    }
+}
+
+
 void xmrig::CpuConfig::setAesMode(const rapidjson::Value &value)
 {
     if (value.IsBool()) {
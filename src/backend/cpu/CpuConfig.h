@@ -23,6 +23,7 @@
 #include "backend/common/Threads.h"
 #include "backend/cpu/CpuLaunchData.h"
 #include "backend/cpu/CpuThreads.h"
+#include "backend/cpu/platform/Cgroup.h"
 #include "crypto/common/Assembly.h"
 
 
@@ -38,14 +39,20 @@ public:
         AES_SOFT
     };
 
+    static const char *kAdaptive;
+    static const char *kCanary;
+    static const char *kCgroup;
+    static const char *kCpuset;
     static const char *kEnabled;
     static const char *kField;
     static const char *kHugePages;
+    static const char *kHugePagesDropCaches;
     static const char *kHugePagesJit;
     static const char *kHwAes;
     static const char *kMaxThreadsHint;
     static const char *kMemoryPool;
     static const char *kPriority;
+    static const char *kSchedBatch;
     static const char *kYield;
 
 #   ifdef XMRIG_FEATURE_ASM
@@ -61,26 +68,40 @@ public:
     bool isHwAES() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     size_t memPoolSize() const;
-    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
+    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm, const Cgroup &cgroup = {}) const;
+    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm, const std::vector<CpuThread> &threads) const;
+    std::vector<CpuThread> fit(const Algorithm &algorithm, const Cgroup &cgroup = {}) const;
     void read(const rapidjson::Value &value);
 
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
+    inline bool isHugePagesDropCaches() const           { return m_dropCaches; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
+    inline bool isSchedBatch() const                    { return m_schedBatch; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline bool isYield() const                         { return m_yield; }
+    inline const String &cgroup() const                 { return m_cgroup; }
+    inline const String &cpuset() const                 { return m_cpuset; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
+    inline uint32_t adaptive() const                    { return m_adaptive; }
+    inline uint32_t canary() const                      { return m_canary; }
     inline uint32_t limit() const                       { return m_limit; }
 
 private:
     constexpr static size_t kDefaultHugePageSizeKb  = 2048U;
     constexpr static size_t kOneGbPageSizeKb        = 1048576U;
+    constexpr static uint32_t kDefaultAdaptiveTrial = 60U;
+    constexpr static uint32_t kDefaultCanary        = 60U;
 
     void generate();
+    void setAdaptive(const rapidjson::Value &value);
+    void setCanary(const rapidjson::Value &value);
+    void setCgroup(const rapidjson::Value &value);
+    void setCpuset(const char *cpuset);
     void setAesMode(const rapidjson::Value &value);
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
@@ -89,15 +110,22 @@ private:
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
+    bool m_dropCaches       = false;
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
+    bool m_schedBatch       = false;
     bool m_shouldSave       = false;
     bool m_yield            = true;
     int m_memoryPool        = 0;
     int m_priority          = -1;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
     String m_argon2Impl;
+    std::set<int64_t> m_cpus;
+    String m_cgroup         = Cgroup::kDefaultRoot;
+    String m_cpuset;
     Threads<CpuThreads> m_threads;
+    uint32_t m_adaptive     = 0;
+    uint32_t m_canary       = kDefaultCanary;
     uint32_t m_limit        = 100;
 };
 
@@ -37,11 +37,13 @@ xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorit
     assembly(config.assembly()),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    schedBatch(config.isSchedBatch()),
     yield(config.isYield()),
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
     threads(threads),
+    canary(config.canary()),
     intensity(std::max<uint32_t>(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity()), algorithm.minIntensity())),
     affinities(affinities)
 {
@@ -54,6 +56,8 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && assembly         == other.assembly
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
+            && schedBatch       == other.schedBatch
+            && canary           == other.canary
             && intensity        == other.intensity
             && priority         == other.priority
             && affinity         == other.affinity
@@ -60,11 +60,13 @@ public:
     const Assembly assembly;
     const bool hugePages;
     const bool hwAES;
+    const bool schedBatch;
     const bool yield;
     const int priority;
     const int64_t affinity;
     const Miner *miner;
     const size_t threads;
+    const uint32_t canary;
     const uint32_t intensity;
     const std::vector<int64_t> affinities;
 };
@@ -17,12 +17,19 @@
  */
 
 #include <cassert>
-#include <thread>
+#include <cinttypes>
+#include <map>
 #include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 
 
+#include "backend/common/Tags.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuWorker.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/Platform.h"
 #include "base/tools/Alignment.h"
 #include "base/tools/Chrono.h"
 #include "core/config/Config.h"
@@ -53,6 +60,7 @@
 namespace xmrig {
 
 static constexpr uint32_t kReserveCount = 32768;
+static constexpr uint64_t kQuarantineErrors = 3;
 
 
 #ifdef XMRIG_ALGO_CN_HEAVY
@@ -60,6 +68,103 @@ static std::mutex cn_heavyZen3MemoryMutex;
 VirtualMemory* cn_heavyZen3Memory = nullptr;
 #endif
 
+
+static const uint8_t *canaryReference(const Algorithm &algorithm)
+{
+    switch (algorithm.id()) {
+    case Algorithm::CN_0:           return test_output_v0;
+    case Algorithm::CN_1:           return test_output_v1;
+    case Algorithm::CN_2:           return test_output_v2;
+    case Algorithm::CN_FAST:        return test_output_msr;
+    case Algorithm::CN_XAO:         return test_output_xao;
+    case Algorithm::CN_RTO:         return test_output_rto;
+    case Algorithm::CN_HALF:        return test_output_half;
+    case Algorithm::CN_R:           return test_output_r;
+    case Algorithm::CN_RWZ:         return test_output_rwz;
+    case Algorithm::CN_ZLS:         return test_output_zls;
+    case Algorithm::CN_CCX:         return test_output_ccx;
+    case Algorithm::CN_DOUBLE:      return test_output_double;
+
+#   ifdef XMRIG_ALGO_CN_LITE
+    case Algorithm::CN_LITE_0:      return test_output_v0_lite;
+    case Algorithm::CN_LITE_1:      return test_output_v1_lite;
+#   endif
+
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    case Algorithm::CN_HEAVY_0:     return test_output_v0_heavy;
+    case Algorithm::CN_HEAVY_XHV:   return test_output_xhv_heavy;
+    case Algorithm::CN_HEAVY_TUBE:  return test_output_tube_heavy;
+#   endif
+
+#   ifdef XMRIG_ALGO_CN_PICO
+    case Algorithm::CN_PICO_0:      return test_output_pico_trtl;
+    case Algorithm::CN_PICO_TLO:    return test_output_pico_tlo;
+#   endif
+
+#   ifdef XMRIG_ALGO_CN_FEMTO
+    case Algorithm::CN_UPX2:        return test_output_femto_upx2;
+#   endif
+
+#   ifdef XMRIG_ALGO_ARGON2
+    case Algorithm::AR2_CHUKWA:     return argon2_chukwa_test_out;
+    case Algorithm::AR2_CHUKWA_V2:  return argon2_chukwa_v2_test_out;
+    case Algorithm::AR2_WRKZ:       return argon2_wrkz_test_out;
+#   endif
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    case Algorithm::GHOSTRIDER_RTM: return test_output_gr;
+#   endif
+
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+// RandomX has no test vector for an arbitrary seed, so threads check each other: the first canary hash
+// computed by two different threads becomes the reference for the algorithm and seed.
+static std::mutex rxCanaryMutex;
+static Algorithm rxCanaryAlgorithm;
+static Buffer rxCanarySeed;
+static std::string rxCanaryReference;
+static std::map<std::string, std::set<size_t> > rxCanaryVotes;
+
+
+// Returns 1 if the hash matches the reference, 0 if it does not and -1 while threads do not agree yet.
+static int rxCanary(const Algorithm &algorithm, const Buffer &seed, size_t id, const uint8_t *hash)
+{
+    std::lock_guard<std::mutex> lock(rxCanaryMutex);
+
+    if (algorithm != rxCanaryAlgorithm || seed != rxCanarySeed) {
+        rxCanaryAlgorithm = algorithm;
+        rxCanarySeed      = seed;
+        rxCanaryReference.clear();
+        rxCanaryVotes.clear();
+    }
+
+    const std::string value(reinterpret_cast<const char *>(hash), 32);
+
+    if (!rxCanaryReference.empty()) {
+        return value == rxCanaryReference ? 1 : 0;
+    }
+
+    auto &votes = rxCanaryVotes[value];
+    votes.insert(id);
+
+    if (votes.size() < 2) {
+        return -1;
+    }
+
+    rxCanaryReference = value;
+    rxCanaryVotes.clear();
+
+    return 1;
+}
+#endif
+
 } // namespace xmrig
 
 
@@ -74,15 +179,16 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_av(data.av()),
     m_miner(data.miner),
     m_threads(data.threads),
+    m_canary(data.canary * 1000ULL),
     m_ctx()
 {
+    if (data.schedBatch) {
+        Platform::setThreadSchedProfile(Platform::SCHED_PROFILE_COMPUTE);
+    }
+
 #   ifdef XMRIG_ALGO_CN_HEAVY
     // cn-heavy optimization for Zen3 CPUs
-    const auto arch = Cpu::info()->arch();
-    const uint32_t model = Cpu::info()->model();
-    const bool is_vermeer = (arch == ICpuInfo::ARCH_ZEN3) && (model == 0x21);
-    const bool is_raphael = (arch == ICpuInfo::ARCH_ZEN4) && (model == 0x61);
-    if ((N == 1) && (m_av == CnHash::AV_SINGLE) && (m_algorithm.family() == Algorithm::CN_HEAVY) && (m_assembly != Assembly::NONE) && (is_vermeer || is_raphael)) {
+    if ((N == 1) && (m_av == CnHash::AV_SINGLE) && (m_algorithm.family() == Algorithm::CN_HEAVY) && (m_assembly != Assembly::NONE) && Cpu::info()->profile().cnHeavyShared) {
         std::lock_guard<std::mutex> lock(cn_heavyZen3MemoryMutex);
         if (!cn_heavyZen3Memory) {
             // Round up number of threads to the multiple of 8
@@ -229,6 +335,15 @@ bool xmrig::CpuWorker<N>::selfTest()
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::canaryData(uint64_t &checks, uint64_t &errors, bool &quarantined) const
+{
+    checks      = m_canaryChecks;
+    errors      = m_canaryErrors;
+    quarantined = m_quarantined;
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t &rawHashes) const
 {
@@ -237,10 +352,29 @@ void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t
 }
 
 
+template<size_t N>
+size_t xmrig::CpuWorker<N>::remoteMemory() const
+{
+    size_t remote = VirtualMemory::remoteBytes(this, sizeof(*this), node());
+
+    if (m_memory) {
+        remote += VirtualMemory::remoteBytes(m_memory->scratchpad(), m_memory->size(), node());
+    }
+
+    return remote;
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
     while (Nonce::sequence(Nonce::CPU) > 0) {
+        if (m_quarantined) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+            continue;
+        }
+
         if (Nonce::isPaused()) {
             do {
                 std::this_thread::sleep_for(std::chrono::milliseconds(20));
@@ -266,6 +400,14 @@ void xmrig::CpuWorker<N>::start()
                 break;
             }
 
+            if (isCanaryDue()) {
+                canary(job);
+
+#               ifdef XMRIG_ALGO_RANDOMX
+                first = true; // the canary reused the scratchpad prepared for the next hash
+#               endif
+            }
+
             uint32_t current_job_nonces[N];
             for (size_t i = 0; i < N; ++i) {
                 current_job_nonces[i] = readUnaligned(m_job.nonce(i));
@@ -348,12 +490,28 @@ void xmrig::CpuWorker<N>::start()
                     else
 #                   endif
                     if (value < job.target()) {
-                        JobResults::submit(job, current_job_nonces[i], m_hash + (i * 32), job.hasMinerSignature() ? miner_signature_saved : nullptr);
+                        const uint8_t *signature = job.hasMinerSignature() ? miner_signature_saved : nullptr;
+
+                        if (m_canary) {
+#                           ifdef XMRIG_ALGO_RANDOMX
+                            first = true;
+#                           endif
+
+                            if (!recheck(job, i, current_job_nonces[i], m_hash + (i * 32), signature)) {
+                                continue;
+                            }
+                        }
+
+                        JobResults::submit(job, current_job_nonces[i], m_hash + (i * 32), signature);
                     }
                 }
                 m_count += N;
             }
 
+            if (m_quarantined) {
+                break;
+            }
+
             if (m_yield) {
                 std::this_thread::yield();
             }
@@ -364,6 +522,19 @@ void xmrig::CpuWorker<N>::start()
 }
 
 
+template<size_t N>
+bool xmrig::CpuWorker<N>::isCanaryDue() const
+{
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    if (m_benchSize) {
+        return false;
+    }
+#   endif
+
+    return m_canary && Chrono::steadyMSecs() >= m_canaryDue;
+}
+
+
 template<size_t N>
 bool xmrig::CpuWorker<N>::nextRound()
 {
@@ -383,6 +554,53 @@ bool xmrig::CpuWorker<N>::nextRound()
 }
 
 
+template<size_t N>
+bool xmrig::CpuWorker<N>::recheck(const Job &job, size_t index, uint32_t nonce, const uint8_t *hash, const uint8_t *minerSignature)
+{
+    // 64-bit nonces are rolled in the job itself, the high half of this share is not known here.
+    if (job.nonceSize() != sizeof(uint32_t)) {
+        return true;
+    }
+
+    const size_t size = job.size();
+    alignas(16) uint8_t blob[Job::kMaxBlobSize];
+    alignas(16) uint8_t out[32];
+
+    memcpy(blob, m_job.blob() + index * size, size);
+    writeUnaligned(reinterpret_cast<uint32_t *>(blob + job.nonceOffset()), nonce);
+
+    if (minerSignature) {
+        memcpy(blob + job.nonceOffset() + job.nonceSize(), minerSignature, 64);
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (job.algorithm().family() == Algorithm::RANDOM_X) {
+        randomx_calculate_hash(m_vm, blob, size, out);
+    }
+    else
+#   endif
+    {
+        // The single hash function is a different code path than the multi hash one, which makes the recheck independent of it.
+        cn_hash_fun func = CnHash::fn(job.algorithm(), m_hwAES ? CnHash::AV_SINGLE : CnHash::AV_SINGLE_SOFT, m_assembly);
+        if (!func) {
+            return true;
+        }
+
+        func(blob, size, out, m_ctx, job.height());
+    }
+
+    ++m_canaryChecks;
+
+    if (memcmp(out, hash, sizeof(out)) != 0) {
+        fault("share");
+
+        return false;
+    }
+
+    return true;
+}
+
+
 template<size_t N>
 bool xmrig::CpuWorker<N>::verify(const Algorithm &algorithm, const uint8_t *referenceValue)
 {
@@ -496,6 +714,72 @@ void xmrig::CpuWorker<N>::allocateCnCtx()
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::canary(const Job &job)
+{
+    m_canaryDue = Chrono::steadyMSecs() + m_canary;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (job.algorithm().family() == Algorithm::RANDOM_X) {
+        alignas(16) uint8_t hash[32]{};
+        randomx_calculate_hash(m_vm, test_input, 76, hash);
+
+        const int rc = rxCanary(job.algorithm(), m_seed, id(), hash);
+        if (rc >= 0) {
+            ++m_canaryChecks;
+        }
+
+        if (rc == 0) {
+            fault("canary");
+        }
+
+        return;
+    }
+#   endif
+
+    const uint8_t *reference = canaryReference(job.algorithm());
+    if (!reference || N * 76 > sizeof(test_input)) {
+        return;
+    }
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    if (job.algorithm().family() == Algorithm::GHOSTRIDER && N != 8) {
+        return;
+    }
+#   endif
+
+    ++m_canaryChecks;
+
+    bool rc = true;
+
+    if (job.algorithm() == Algorithm::CN_R) {
+        // m_job.blob() holds the current job, so the first cn/r vector is hashed from a local copy.
+        cn_hash_fun func = fn(job.algorithm());
+        const auto &input = cn_r_test_input[0];
+
+        alignas(16) uint8_t blob[N * sizeof(input.data)];
+        for (size_t i = 0; i < N; ++i) {
+            memcpy(blob + i * input.size, input.data, input.size);
+        }
+
+        if (func) {
+            func(blob, input.size, m_hash, m_ctx, input.height);
+
+            for (size_t i = 0; i < N; ++i) {
+                rc = rc && memcmp(m_hash + i * 32, reference, 32) == 0;
+            }
+        }
+    }
+    else {
+        rc = verify(job.algorithm(), reference);
+    }
+
+    if (!rc) {
+        fault("canary");
+    }
+}
+
+
 template<size_t N>
 void xmrig::CpuWorker<N>::consumeJob()
 {
@@ -526,6 +810,22 @@ void xmrig::CpuWorker<N>::consumeJob()
 }
 
 
+template<size_t N>
+void xmrig::CpuWorker<N>::fault(const char *reason)
+{
+    ++m_canaryErrors;
+
+    LOG_ERR("%s " RED_BOLD("thread #%zu") RED(" on CPU %" PRId64 " computed a wrong %s hash, errors ") RED_BOLD("%" PRIu64 "/%" PRIu64),
+            cpu_tag(), id(), affinity(), reason, m_canaryErrors, m_canaryChecks);
+
+    if (!m_quarantined && m_canaryErrors >= kQuarantineErrors) {
+        m_quarantined = true;
+
+        LOG_ERR("%s " RED_BOLD("thread #%zu quarantined") RED(", check overclocking, undervolting and cooling of CPU %" PRId64), cpu_tag(), id(), affinity());
+    }
+}
+
+
 namespace xmrig {
 
 template class CpuWorker<1>;
@@ -63,11 +63,14 @@ public:
 
 protected:
     bool selfTest() override;
+    void canaryData(uint64_t &checks, uint64_t &errors, bool &quarantined) const override;
     void hashrateData(uint64_t &hashCount, uint64_t &timeStamp, uint64_t &rawHashes) const override;
     void start() override;
 
     inline const VirtualMemory *memory() const override     { return m_memory; }
     inline size_t intensity() const override                { return N; }
+
+    size_t remoteMemory() const override;
     inline void jobEarlyNotification(const Job&) override   {}
 
 private:
@@ -77,13 +80,18 @@ private:
     void allocateRandomX_VM();
 #   endif
 
+    bool isCanaryDue() const;
     bool nextRound();
+    bool recheck(const Job &job, size_t index, uint32_t nonce, const uint8_t *hash, const uint8_t *minerSignature);
     bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
     void allocateCnCtx();
+    void canary(const Job &job);
     void consumeJob();
+    void fault(const char *reason);
 
     alignas(8) uint8_t m_hash[N * 32]{ 0 };
+    bool m_quarantined      = false;
     const Algorithm m_algorithm;
     const Assembly m_assembly;
     const bool m_hwAES;
@@ -91,7 +99,11 @@ private:
     const CnHash::AlgoVariant m_av;
     const Miner *m_miner;
     const size_t m_threads;
+    const uint64_t m_canary;
     cryptonight_ctx *m_ctx[N];
+    uint64_t m_canaryChecks = 0;
+    uint64_t m_canaryDue    = 0;
+    uint64_t m_canaryErrors = 0;
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
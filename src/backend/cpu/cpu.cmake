@@ -1,5 +1,6 @@
 set(HEADERS_BACKEND_CPU
     src/backend/cpu/Cpu.h
+    src/backend/cpu/CpuAdaptive.h
     src/backend/cpu/CpuBackend.h
     src/backend/cpu/CpuConfig_gen.h
     src/backend/cpu/CpuConfig.h
@@ -9,16 +10,23 @@ set(HEADERS_BACKEND_CPU
     src/backend/cpu/CpuWorker.h
     src/backend/cpu/interfaces/ICpuInfo.h
     src/backend/cpu/platform/BasicCpuInfo.h
+    src/backend/cpu/platform/Cgroup.h
+    src/backend/cpu/platform/CoreRanking.h
+    src/backend/cpu/platform/CpuProfile.h
    )
 
 set(SOURCES_BACKEND_CPU
     src/backend/cpu/Cpu.cpp
+    src/backend/cpu/CpuAdaptive.cpp
     src/backend/cpu/CpuBackend.cpp
     src/backend/cpu/CpuConfig.cpp
     src/backend/cpu/CpuLaunchData.h
     src/backend/cpu/CpuThread.cpp
     src/backend/cpu/CpuThreads.cpp
     src/backend/cpu/CpuWorker.cpp
+    src/backend/cpu/platform/Cgroup.cpp
+    src/backend/cpu/platform/CoreRanking.cpp
+    src/backend/cpu/platform/CpuProfile.cpp
    )
 
 if (WITH_HWLOC)
@@ -38,8 +46,15 @@ if (WITH_HWLOC)
         add_definitions(/DXMRIG_HWLOC_DEBUG)
     endif()
 
-    list(APPEND HEADERS_BACKEND_CPU src/backend/cpu/platform/HwlocCpuInfo.h)
-    list(APPEND SOURCES_BACKEND_CPU src/backend/cpu/platform/HwlocCpuInfo.cpp)
+    list(APPEND HEADERS_BACKEND_CPU
+        src/backend/cpu/platform/HwlocCpuInfo.h
+        src/backend/cpu/platform/MemoryTiers.h
+        )
+
+    list(APPEND SOURCES_BACKEND_CPU
+        src/backend/cpu/platform/HwlocCpuInfo.cpp
+        src/backend/cpu/platform/MemoryTiers.cpp
+        )
 else()
     remove_definitions(/DXMRIG_FEATURE_HWLOC)
 
@@ -35,6 +35,10 @@ using hwloc_topology_t      = struct hwloc_topology *;
 namespace xmrig {
 
 
+class CoreRanking;
+struct CpuProfile;
+
+
 class ICpuInfo
 {
 public:
@@ -43,7 +47,8 @@ public:
     enum Vendor : uint32_t {
         VENDOR_UNKNOWN,
         VENDOR_INTEL,
-        VENDOR_AMD
+        VENDOR_AMD,
+        VENDOR_ARM
     };
 
     enum Arch : uint32_t {
@@ -52,7 +57,19 @@ public:
         ARCH_ZEN_PLUS,
         ARCH_ZEN2,
         ARCH_ZEN3,
-        ARCH_ZEN4
+        ARCH_ZEN4,
+        ARCH_ZEN5,
+        ARCH_SKYLAKE,
+        ARCH_ALDER_LAKE,
+        ARCH_RAPTOR_LAKE,
+        ARCH_ARROW_LAKE,
+        ARCH_SAPPHIRE_RAPIDS,
+        ARCH_EMERALD_RAPIDS,
+        ARCH_GRANITE_RAPIDS,
+        ARCH_NEOVERSE_N1,
+        ARCH_NEOVERSE_V1,
+        ARCH_NEOVERSE_V2,
+        ARCH_AMPERE_ONE
     };
 
     enum MsrMod : uint32_t {
@@ -60,12 +77,13 @@ public:
         MSR_MOD_RYZEN_17H,
         MSR_MOD_RYZEN_19H,
         MSR_MOD_RYZEN_19H_ZEN4,
+        MSR_MOD_RYZEN_1AH_ZEN5,
         MSR_MOD_INTEL,
         MSR_MOD_CUSTOM,
         MSR_MOD_MAX
     };
 
-#   define MSR_NAMES_LIST "none", "ryzen_17h", "ryzen_19h", "ryzen_19h_zen4", "intel", "custom"
+#   define MSR_NAMES_LIST "none", "ryzen_17h", "ryzen_19h", "ryzen_19h_zen4", "ryzen_1ah_zen5", "intel", "custom"
 
     enum Flag : uint32_t {
         FLAG_AES,
@@ -110,6 +128,8 @@ public:
     virtual bool jccErratum() const                                                 = 0;
     virtual const char *backend() const                                             = 0;
     virtual const char *brand() const                                               = 0;
+    virtual const CoreRanking &ranking() const                                      = 0;
+    virtual const CpuProfile &profile() const                                       = 0;
     virtual const std::vector<int32_t> &units() const                               = 0;
     virtual CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const    = 0;
     virtual MsrMod msrMod() const                                                   = 0;
@@ -64,7 +64,7 @@ static_assert(kCpuFlagsSize == ICpuInfo::FLAG_MAX, "kCpuFlagsSize and FLAG_MAX m
 
 
 #ifdef XMRIG_FEATURE_MSR
-constexpr size_t kMsrArraySize                                  = 6;
+constexpr size_t kMsrArraySize                                  = 7;
 static const std::array<const char *, kMsrArraySize> msrNames   = { MSR_NAMES_LIST };
 static_assert(kMsrArraySize == ICpuInfo::MSR_MOD_MAX, "kMsrArraySize and MSR_MOD_MAX mismatch");
 #endif
@@ -223,86 +223,13 @@ xmrig::BasicCpuInfo::BasicCpuInfo() :
 
         if (memcmp(vendor, "AuthenticAMD", 12) == 0) {
             m_vendor = VENDOR_AMD;
-
-            if (m_family >= 0x17) {
-                m_assembly = Assembly::RYZEN;
-
-                switch (m_family) {
-                case 0x17:
-                    m_msrMod = MSR_MOD_RYZEN_17H;
-                    switch (m_model) {
-                    case 1:
-                    case 17:
-                    case 32:
-                        m_arch = ARCH_ZEN;
-                        break;
-                    case 8:
-                    case 24:
-                        m_arch = ARCH_ZEN_PLUS;
-                        break;
-                    case 49:
-                    case 96:
-                    case 113:
-                    case 144:
-                        m_arch = ARCH_ZEN2;
-                        break;
-                    }
-                    break;
-
-                case 0x19:
-                    if (m_model == 0x61) {
-                        m_arch = ARCH_ZEN4;
-                        m_msrMod = MSR_MOD_RYZEN_19H_ZEN4;
-                    }
-                    else {
-                        m_arch = ARCH_ZEN3;
-                        m_msrMod = MSR_MOD_RYZEN_19H;
-                    }
-                    break;
-
-                default:
-                    m_msrMod = MSR_MOD_NONE;
-                    break;
-                }
-            }
-            else {
-                m_assembly = Assembly::BULLDOZER;
-            }
         }
         else if (memcmp(vendor, "GenuineIntel", 12) == 0) {
-            m_vendor   = VENDOR_INTEL;
-            m_assembly = Assembly::INTEL;
-            m_msrMod   = MSR_MOD_INTEL;
-
-            struct
-            {
-                unsigned int stepping : 4;
-                unsigned int model : 4;
-                unsigned int family : 4;
-                unsigned int processor_type : 2;
-                unsigned int reserved1 : 2;
-                unsigned int ext_model : 4;
-                unsigned int ext_family : 8;
-                unsigned int reserved2 : 4;
-            } processor_info;
-
-            memcpy(&processor_info, data, sizeof(processor_info));
-
-            // Intel JCC erratum mitigation
-            if (processor_info.family == 6) {
-                const uint32_t model = processor_info.model | (processor_info.ext_model << 4);
-                const uint32_t stepping = processor_info.stepping;
-
-                // Affected CPU models and stepping numbers are taken from https://www.intel.com/content/dam/support/us/en/documents/processors/mitigations-jump-conditional-code-erratum.pdf
-                m_jccErratum =
-                    ((model == 0x4E) && (stepping == 0x3)) ||
-                    ((model == 0x55) && ((stepping == 0x4) || (stepping == 0x7))) ||
-                    ((model == 0x5E) && (stepping == 0x3)) ||
-                    ((model == 0x8E) && (stepping >= 0x9) && (stepping <= 0xC)) ||
-                    ((model == 0x9E) && (stepping >= 0x9) && (stepping <= 0xD)) ||
-                    ((model == 0xA6) && (stepping == 0x0)) ||
-                    ((model == 0xAE) && (stepping == 0xA));
-            }
+            m_vendor = VENDOR_INTEL;
+        }
+
+        if (m_vendor != VENDOR_UNKNOWN) {
+            m_profile = &CpuProfile::find(m_vendor, m_family, m_model, m_stepping);
         }
     }
 #   endif
@@ -389,6 +316,8 @@ rapidjson::Value xmrig::BasicCpuInfo::toJSON(rapidjson::Document &doc) const
     out.AddMember("family",     m_family, allocator);
     out.AddMember("model",      m_model, allocator);
     out.AddMember("stepping",   m_stepping, allocator);
+    out.AddMember("uarch",      StringRef(profile().name), allocator);
+    out.AddMember("uarch_version", static_cast<uint32_t>(CpuProfile::kVersion), allocator);
     out.AddMember("proc_info",  m_procInfo, allocator);
     out.AddMember("aes",        hasAES(), allocator);
     out.AddMember("avx2",       hasAVX2(), allocator);
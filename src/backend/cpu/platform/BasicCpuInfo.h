@@ -22,6 +22,8 @@
 
 
 #include "backend/cpu/interfaces/ICpuInfo.h"
+#include "backend/cpu/platform/CoreRanking.h"
+#include "backend/cpu/platform/CpuProfile.h"
 
 
 #include <bitset>
@@ -40,8 +42,8 @@ protected:
     CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const override;
     rapidjson::Value toJSON(rapidjson::Document &doc) const override;
 
-    inline Arch arch() const override                           { return m_arch; }
-    inline Assembly::Id assembly() const override               { return m_assembly; }
+    inline Arch arch() const override                           { return m_profile->arch; }
+    inline Assembly::Id assembly() const override               { return m_profile->assembly; }
     inline bool has(Flag flag) const override                   { return m_flags.test(flag); }
     inline bool hasAES() const override                         { return has(FLAG_AES); }
     inline bool hasVAES() const override                        { return has(FLAG_VAES); }
@@ -52,10 +54,12 @@ protected:
     inline bool hasOneGbPages() const override                  { return has(FLAG_PDPE1GB); }
     inline bool hasXOP() const override                         { return has(FLAG_XOP); }
     inline bool isVM() const override                           { return has(FLAG_VM); }
-    inline bool jccErratum() const override                     { return m_jccErratum; }
+    inline bool jccErratum() const override                     { return m_profile->jccErratum; }
     inline const char *brand() const override                   { return m_brand; }
+    inline const CoreRanking &ranking() const override          { return m_ranking; }
+    inline const CpuProfile &profile() const override           { return *m_profile; }
     inline const std::vector<int32_t> &units() const override   { return m_units; }
-    inline MsrMod msrMod() const override                       { return m_msrMod; }
+    inline MsrMod msrMod() const override                       { return m_profile->msrMod; }
     inline size_t cores() const override                        { return 0; }
     inline size_t L2() const override                           { return 0; }
     inline size_t L3() const override                           { return 0; }
@@ -72,9 +76,9 @@ protected:
 #   endif
     }
 
-    Arch m_arch             = ARCH_UNKNOWN;
-    bool m_jccErratum       = false;
     char m_brand[64 + 6]{};
+    CoreRanking m_ranking;
+    const CpuProfile *m_profile = &CpuProfile::unknown();
     size_t m_threads        = 0;
     std::vector<int32_t> m_units;
     Vendor m_vendor         = VENDOR_UNKNOWN;
@@ -87,8 +91,6 @@ private:
     uint32_t m_stepping     = 0;
 #   endif
 
-    Assembly m_assembly     = Assembly::NONE;
-    MsrMod m_msrMod         = MSR_MOD_NONE;
     std::bitset<FLAG_MAX> m_flags;
 };
 
@@ -46,6 +46,7 @@
 #if defined(XMRIG_OS_UNIX)
 namespace xmrig {
 
+extern bool cpu_id_arm(uint32_t &implementer, uint32_t &part);
 extern String cpu_name_arm();
 
 } // namespace xmrig
@@ -85,6 +86,14 @@ xmrig::BasicCpuInfo::BasicCpuInfo() :
         strncpy(m_brand, name, sizeof(m_brand) - 1);
     }
 
+    uint32_t implementer = 0;
+    uint32_t part        = 0;
+
+    if (cpu_id_arm(implementer, part)) {
+        m_vendor  = VENDOR_ARM;
+        m_profile = &CpuProfile::find(m_vendor, implementer, part, 0);
+    }
+
     m_flags.set(FLAG_PDPE1GB, std::ifstream("/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages").good());
 #   elif defined(XMRIG_OS_MACOS)
     size_t buflen = sizeof(m_brand);
@@ -119,6 +128,8 @@ rapidjson::Value xmrig::BasicCpuInfo::toJSON(rapidjson::Document &doc) const
     Value out(kObjectType);
 
     out.AddMember("brand",      StringRef(brand()), allocator);
+    out.AddMember("uarch",      StringRef(profile().name), allocator);
+    out.AddMember("uarch_version", static_cast<uint32_t>(CpuProfile::kVersion), allocator);
     out.AddMember("aes",        hasAES(), allocator);
     out.AddMember("avx2",       false, allocator);
     out.AddMember("x64",        is64bit(), allocator); // DEPRECATED will be removed in the next major release.
@@ -0,0 +1,315 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/platform/Cgroup.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+
+namespace xmrig {
+
+
+const char *Cgroup::kDefaultRoot = "/sys/fs/cgroup";
+
+
+#ifdef XMRIG_OS_LINUX
+static bool readLine(const std::string &fileName, std::string &line)
+{
+    std::ifstream ifs(fileName);
+
+    return ifs.is_open() && std::getline(ifs, line) && !line.empty();
+}
+
+
+static String resolve(const String &root)
+{
+    std::ifstream ifs(std::string(root) + "/cgroup.controllers");
+    if (!ifs.is_open()) {
+        return {};
+    }
+
+    // Custom root is treated as the process cgroup directory, it's useful to test against a fake cgroupfs tree.
+    if (root != Cgroup::kDefaultRoot) {
+        return root;
+    }
+
+    std::ifstream proc("/proc/self/cgroup");
+    std::string line;
+
+    while (std::getline(proc, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            const std::string path = line.substr(3);
+
+            return path.empty() || path == "/" ? root : String((root.data() + path).c_str());
+        }
+    }
+
+    return root;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::Cgroup xmrig::Cgroup::read(const String &root)
+{
+    Cgroup cgroup;
+
+#   ifdef XMRIG_OS_LINUX
+    if (root.isEmpty()) {
+        return cgroup;
+    }
+
+    cgroup.m_path = resolve(root);
+    if (!cgroup.isValid()) {
+        return cgroup;
+    }
+
+    std::string path = cgroup.m_path.data();
+    std::string line;
+
+    if (readLine(path + "/cpu.weight", line)) {
+        cgroup.m_weight = strtoull(line.c_str(), nullptr, 10);
+    }
+
+    cgroup.readCpus(path + "/cpuset.cpus.effective");
+    cgroup.readCpuStat(path + "/cpu.stat");
+
+    // Quota of any ancestor limits the process too, the smallest one wins.
+    while (path.size() >= root.size()) {
+        cgroup.readCpuMax(path + "/cpu.max");
+
+        const size_t pos = path.rfind('/');
+        if (path.size() == root.size() || pos == std::string::npos) {
+            break;
+        }
+
+        path.resize(pos);
+    }
+#   endif
+
+    return cgroup;
+}
+
+
+std::set<int64_t> xmrig::Cgroup::parseCpus(const char *list)
+{
+    std::set<int64_t> cpus;
+    const char *p = list;
+    char *end     = nullptr;
+
+    while (p && *p && !isspace(static_cast<unsigned char>(*p))) {
+        const int64_t first = strtoll(p, &end, 10);
+        if (end == p || first < 0) {
+            return {};
+        }
+
+        int64_t last = first;
+        p = end;
+
+        if (*p == '-') {
+            last = strtoll(p + 1, &end, 10);
+            if (end == p + 1) {
+                return {};
+            }
+
+            p = end;
+        }
+
+        // Malformed or hostile lists would allocate a node per CPU, the whole list is rejected instead.
+        if (last < first || last >= kMaxCpus) {
+            return {};
+        }
+
+        for (int64_t cpu = first; cpu <= last; ++cpu) {
+            cpus.insert(cpu);
+        }
+
+        if (*p == ',') {
+            ++p;
+        }
+        else if (*p && !isspace(static_cast<unsigned char>(*p))) {
+            return {};
+        }
+    }
+
+    return cpus;
+}
+
+
+std::vector<xmrig::CpuThread> xmrig::Cgroup::fit(const std::vector<CpuThread> &threads, const std::set<int64_t> &cpus, uint32_t max, bool pin)
+{
+    auto isAllowed = [&cpus, pin](int64_t cpu) { return cpu < 0 ? (!pin || cpus.empty()) : (cpus.empty() || cpus.count(cpu) > 0); };
+
+    std::set<int64_t> used;
+    for (const auto &thread : threads) {
+        if (thread.affinity() >= 0 && isAllowed(thread.affinity())) {
+            used.insert(thread.affinity());
+        }
+    }
+
+    std::vector<CpuThread> out;
+    out.reserve(threads.size());
+
+    auto next = cpus.begin();
+
+    for (const auto &thread : threads) {
+        if (isAllowed(thread.affinity())) {
+            out.emplace_back(thread);
+
+            continue;
+        }
+
+        // Move the thread from a forbidden CPU, or pin an unpinned one, to an allowed CPU which is not used yet, or drop it.
+        while (next != cpus.end() && used.count(*next)) {
+            ++next;
+        }
+
+        if (next != cpus.end()) {
+            used.insert(*next);
+            out.emplace_back(*next, thread.intensity());
+        }
+    }
+
+    if (max && out.size() > max) {
+        out.resize(max);
+    }
+
+    return out;
+}
+
+
+bool xmrig::Cgroup::isAllowed(int64_t cpu) const
+{
+    return cpu < 0 || m_cpus.empty() || m_cpus.count(cpu) > 0;
+}
+
+
+bool xmrig::Cgroup::isEqual(const Cgroup &other) const
+{
+    return m_path == other.m_path && limit() == other.limit() && m_cpus == other.m_cpus;
+}
+
+
+rapidjson::Value xmrig::Cgroup::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+
+    if (!isValid()) {
+        return Value(kNullType);
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    Value cpus(kArrayType);
+    for (const int64_t cpu : m_cpus) {
+        cpus.PushBack(cpu, allocator);
+    }
+
+    Value obj(kObjectType);
+    obj.AddMember("path",           m_path.toJSON(doc), allocator);
+    obj.AddMember("quota",          m_quota > 0.0 ? Json::normalize(m_quota, false) : Value(kNullType), allocator);
+    obj.AddMember("weight",         m_weight, allocator);
+    obj.AddMember("cpus",           cpus, allocator);
+    obj.AddMember("limit",          limit(), allocator);
+    obj.AddMember("nr_periods",     m_nrPeriods, allocator);
+    obj.AddMember("nr_throttled",   m_nrThrottled, allocator);
+    obj.AddMember("throttled_usec", m_throttledUsec, allocator);
+
+    return obj;
+}
+
+
+std::vector<xmrig::CpuThread> xmrig::Cgroup::fit(const std::vector<CpuThread> &threads) const
+{
+    if (!isValid()) {
+        return threads;
+    }
+
+    return fit(threads, m_cpus, limit(), false);
+}
+
+
+uint32_t xmrig::Cgroup::limit() const
+{
+    uint32_t max = m_cpus.empty() ? 0 : static_cast<uint32_t>(m_cpus.size());
+
+    if (m_quota > 0.0) {
+        const auto quota = std::max<uint32_t>(static_cast<uint32_t>(std::floor(m_quota + 0.01)), 1);
+
+        max = max ? std::min(max, quota) : quota;
+    }
+
+    return max;
+}
+
+
+#ifdef XMRIG_OS_LINUX
+void xmrig::Cgroup::readCpuMax(const std::string &path)
+{
+    std::string line;
+    if (!readLine(path, line) || line.compare(0, 3, "max") == 0) {
+        return;
+    }
+
+    char *end           = nullptr;
+    const double max    = strtod(line.c_str(), &end);
+    const double period = end ? strtod(end, nullptr) : 0.0;
+
+    if (max > 0.0 && period > 0.0 && (m_quota == 0.0 || max / period < m_quota)) {
+        m_quota = max / period;
+    }
+}
+
+
+void xmrig::Cgroup::readCpuStat(const std::string &path)
+{
+    std::ifstream ifs(path);
+    std::string key;
+    uint64_t value = 0;
+
+    while (ifs >> key >> value) {
+        if (key == "nr_periods") {
+            m_nrPeriods = value;
+        }
+        else if (key == "nr_throttled") {
+            m_nrThrottled = value;
+        }
+        else if (key == "throttled_usec") {
+            m_throttledUsec = value;
+        }
+    }
+}
+
+
+void xmrig::Cgroup::readCpus(const std::string &path)
+{
+    std::string line;
+    if (readLine(path, line)) {
+        m_cpus = parseCpus(line.c_str());
+    }
+}
+#endif
@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CGROUP_H
+#define XMRIG_CGROUP_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/cpu/CpuThread.h"
+#include "base/tools/String.h"
+
+
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Snapshot of the cgroup v2 limits applied to the process: CFS quota (cpu.max, the smallest
+ * one in the hierarchy), cpu.weight, allowed CPUs (cpuset.cpus.effective) and throttling
+ * counters from cpu.stat. Only Linux is supported, on other systems the snapshot is always invalid.
+ */
+class Cgroup
+{
+public:
+    static const char *kDefaultRoot;
+
+    constexpr static int64_t kMaxCpus = 8192;
+
+    Cgroup() = default;
+
+    static Cgroup read(const String &root);
+    static std::set<int64_t> parseCpus(const char *list);
+    static std::vector<CpuThread> fit(const std::vector<CpuThread> &threads, const std::set<int64_t> &cpus, uint32_t max, bool pin);
+
+    inline bool isValid() const                     { return !m_path.isNull(); }
+    inline const std::set<int64_t> &cpus() const    { return m_cpus; }
+    inline const String &path() const               { return m_path; }
+    inline double quota() const                     { return m_quota; }
+
+    inline bool operator!=(const Cgroup &other) const   { return !isEqual(other); }
+    inline bool operator==(const Cgroup &other) const   { return isEqual(other); }
+
+    bool isAllowed(int64_t cpu) const;
+    bool isEqual(const Cgroup &other) const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    std::vector<CpuThread> fit(const std::vector<CpuThread> &threads) const;
+    uint32_t limit() const;
+
+private:
+    void readCpuMax(const std::string &path);
+    void readCpuStat(const std::string &path);
+    void readCpus(const std::string &path);
+
+    double m_quota              = 0.0;
+    std::set<int64_t> m_cpus;
+    String m_path;
+    uint64_t m_nrPeriods        = 0;
+    uint64_t m_nrThrottled      = 0;
+    uint64_t m_throttledUsec    = 0;
+    uint64_t m_weight           = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CGROUP_H */
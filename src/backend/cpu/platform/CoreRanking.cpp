@@ -0,0 +1,127 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/platform/CoreRanking.h"
+
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <string>
+
+
+namespace xmrig {
+
+
+const char *CoreRanking::kDefaultRoot = "/sys/devices/system/cpu";
+
+
+#ifdef XMRIG_OS_LINUX
+static uint64_t readValue(const String &root, int32_t pu, const char *name)
+{
+    std::ifstream ifs(std::string(root) + "/cpu" + std::to_string(pu) + "/" + name);
+    uint64_t value = 0;
+
+    return (ifs >> value) ? value : 0;
+}
+
+
+static bool readAll(const String &root, const std::vector<int32_t> &units, const char *name, std::map<int32_t, uint64_t> &ranks)
+{
+    ranks.clear();
+
+    for (int32_t pu : units) {
+        const uint64_t value = readValue(root, pu, name);
+        if (!value) {
+            return false;
+        }
+
+        ranks.insert({ pu, value });
+    }
+
+    return !ranks.empty();
+}
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::CoreRanking xmrig::CoreRanking::read(const String &root, const std::vector<int32_t> &units)
+{
+    CoreRanking ranking;
+
+#   ifdef XMRIG_OS_LINUX
+    if (root.isEmpty()) {
+        return ranking;
+    }
+
+    // A partial ranking is worse than none, every CPU must report the same kind of value.
+    if (readAll(root, units, "acpi_cppc/highest_perf", ranking.m_ranks)) {
+        ranking.m_source = CPPC;
+    }
+    else if (readAll(root, units, "cpufreq/cpuinfo_max_freq", ranking.m_ranks)) {
+        ranking.m_source = CPUFREQ;
+    }
+
+    std::set<uint64_t> levels;
+    for (const auto &kv : ranking.m_ranks) {
+        levels.insert(kv.second);
+    }
+
+    ranking.m_levels = levels.size();
+#   endif
+
+    return ranking;
+}
+
+
+const char *xmrig::CoreRanking::sourceName() const
+{
+    static const char *names[] = { "none", "cppc", "cpufreq" };
+
+    return names[m_source];
+}
+
+
+std::vector<int32_t> xmrig::CoreRanking::preferred() const
+{
+    std::vector<int32_t> out;
+    uint64_t top = 0;
+
+    for (const auto &kv : m_ranks) {
+        top = std::max(top, kv.second);
+    }
+
+    for (const auto &kv : m_ranks) {
+        if (kv.second == top) {
+            out.emplace_back(kv.first);
+        }
+    }
+
+    return out;
+}
+
+
+uint64_t xmrig::CoreRanking::rank(int32_t pu) const
+{
+    const auto it = m_ranks.find(pu);
+
+    return it != m_ranks.end() ? it->second : 0;
+}
@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CORERANKING_H
+#define XMRIG_CORERANKING_H
+
+
+#include "base/tools/String.h"
+
+
+#include <map>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Per logical CPU performance ranking from the kernel: ACPI CPPC highest_perf (AMD preferred cores, Intel Turbo Boost Max 3.0)
+ * or cpuinfo_max_freq when CPPC is not available. Only Linux is supported, on other systems the ranking is always invalid.
+ */
+class CoreRanking
+{
+public:
+    enum Source : uint32_t {
+        NONE,
+        CPPC,
+        CPUFREQ
+    };
+
+    static const char *kDefaultRoot;
+
+    CoreRanking() = default;
+
+    static CoreRanking read(const String &root, const std::vector<int32_t> &units);
+
+    inline bool isValid() const                 { return m_levels > 1; }
+    inline size_t levels() const                { return m_levels; }
+    inline Source source() const                { return m_source; }
+
+    const char *sourceName() const;
+    std::vector<int32_t> preferred() const;
+    uint64_t rank(int32_t pu) const;
+
+private:
+    size_t m_levels     = 0;
+    Source m_source     = NONE;
+    std::map<int32_t, uint64_t> m_ranks;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CORERANKING_H */
@@ -0,0 +1,167 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/platform/CpuProfile.h"
+
+
+#include <cstdio>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+constexpr CpuProfile::Range kAny = { 0, 0xFFFFFFFF };
+
+constexpr auto AMD          = ICpuInfo::VENDOR_AMD;
+constexpr auto INTEL        = ICpuInfo::VENDOR_INTEL;
+constexpr auto ARM          = ICpuInfo::VENDOR_ARM;
+
+constexpr auto SCALAR       = CpuProfile::DATASET_INIT_SCALAR;
+constexpr auto AVX2         = CpuProfile::DATASET_INIT_AVX2;
+constexpr auto AVX2_NO_SMT  = CpuProfile::DATASET_INIT_AVX2_NO_SMT;
+
+
+static const CpuProfile kUnknown = { ICpuInfo::VENDOR_UNKNOWN, kAny, kAny, kAny, "unknown", ICpuInfo::ARCH_UNKNOWN, ICpuInfo::MSR_MOD_NONE, Assembly::NONE, SCALAR, false, false };
+
+
+// The first matching entry wins, so exact models and steppings go before ranges and the per vendor fallbacks go last.
+static const CpuProfile kProfiles[] = {
+    //  vendor  family          model           stepping        name                    arch                            MSR mod                                 assembly            dataset init  JCC    cn-heavy
+    { AMD,      { 0x17, 0x17 }, { 0x08, 0x08 }, kAny,           "Zen+",                 ICpuInfo::ARCH_ZEN_PLUS,        ICpuInfo::MSR_MOD_RYZEN_17H,            Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      { 0x17, 0x17 }, { 0x18, 0x18 }, kAny,           "Zen+",                 ICpuInfo::ARCH_ZEN_PLUS,        ICpuInfo::MSR_MOD_RYZEN_17H,            Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      { 0x17, 0x17 }, { 0x00, 0x2F }, kAny,           "Zen",                  ICpuInfo::ARCH_ZEN,             ICpuInfo::MSR_MOD_RYZEN_17H,            Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      { 0x17, 0x17 }, { 0x30, 0xFF }, kAny,           "Zen 2",                ICpuInfo::ARCH_ZEN2,            ICpuInfo::MSR_MOD_RYZEN_17H,            Assembly::RYZEN,    AVX2_NO_SMT,  false, false },
+    { AMD,      { 0x19, 0x19 }, { 0x21, 0x21 }, kAny,           "Zen 3 (Vermeer)",      ICpuInfo::ARCH_ZEN3,            ICpuInfo::MSR_MOD_RYZEN_19H,            Assembly::RYZEN,    AVX2,         false, true  },
+    { AMD,      { 0x19, 0x19 }, { 0x61, 0x61 }, kAny,           "Zen 4 (Raphael)",      ICpuInfo::ARCH_ZEN4,            ICpuInfo::MSR_MOD_RYZEN_19H_ZEN4,       Assembly::RYZEN,    SCALAR,       false, true  },
+    { AMD,      { 0x19, 0x19 }, { 0x10, 0x1F }, kAny,           "Zen 4 (Genoa)",        ICpuInfo::ARCH_ZEN4,            ICpuInfo::MSR_MOD_RYZEN_19H_ZEN4,       Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      { 0x19, 0x19 }, { 0x60, 0x7F }, kAny,           "Zen 4",                ICpuInfo::ARCH_ZEN4,            ICpuInfo::MSR_MOD_RYZEN_19H_ZEN4,       Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      { 0x19, 0x19 }, { 0xA0, 0xAF }, kAny,           "Zen 4c",               ICpuInfo::ARCH_ZEN4,            ICpuInfo::MSR_MOD_RYZEN_19H_ZEN4,       Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      { 0x19, 0x19 }, kAny,           kAny,           "Zen 3",                ICpuInfo::ARCH_ZEN3,            ICpuInfo::MSR_MOD_RYZEN_19H,            Assembly::RYZEN,    AVX2,         false, false },
+    { AMD,      { 0x1A, 0x1A }, kAny,           kAny,           "Zen 5",                ICpuInfo::ARCH_ZEN5,            ICpuInfo::MSR_MOD_RYZEN_1AH_ZEN5,       Assembly::RYZEN,    AVX2,         false, false },
+    { AMD,      { 0x1B, 0xFF }, kAny,           kAny,           "Zen",                  ICpuInfo::ARCH_UNKNOWN,         ICpuInfo::MSR_MOD_NONE,                 Assembly::RYZEN,    SCALAR,       false, false },
+    { AMD,      kAny,           kAny,           kAny,           "Bulldozer",            ICpuInfo::ARCH_UNKNOWN,         ICpuInfo::MSR_MOD_NONE,                 Assembly::BULLDOZER, SCALAR,      false, false },
+
+    // Affected models and steppings are taken from https://www.intel.com/content/dam/support/us/en/documents/processors/mitigations-jump-conditional-code-erratum.pdf
+    { INTEL,    { 0x06, 0x06 }, { 0x4E, 0x4E }, { 0x03, 0x03 }, "Skylake",              ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0x55, 0x55 }, { 0x04, 0x04 }, "Skylake-SP",           ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0x55, 0x55 }, { 0x07, 0x07 }, "Cascade Lake",         ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0x5E, 0x5E }, { 0x03, 0x03 }, "Skylake",              ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0x8E, 0x8E }, { 0x09, 0x0C }, "Kaby Lake",            ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0x9E, 0x9E }, { 0x09, 0x0D }, "Coffee Lake",          ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0xA6, 0xA6 }, { 0x00, 0x00 }, "Comet Lake",           ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0xAE, 0xAE }, { 0x0A, 0x0A }, "Kaby Lake",            ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  true,  false },
+    { INTEL,    { 0x06, 0x06 }, { 0x4E, 0x4E }, kAny,           "Skylake",              ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x55, 0x55 }, kAny,           "Skylake-SP",           ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x5E, 0x5E }, kAny,           "Skylake",              ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x8E, 0x8E }, kAny,           "Kaby Lake",            ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x9E, 0x9E }, kAny,           "Coffee Lake",          ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xA5, 0xA6 }, kAny,           "Comet Lake",           ICpuInfo::ARCH_SKYLAKE,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x97, 0x97 }, kAny,           "Alder Lake",           ICpuInfo::ARCH_ALDER_LAKE,      ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x9A, 0x9A }, kAny,           "Alder Lake",           ICpuInfo::ARCH_ALDER_LAKE,      ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xBE, 0xBE }, kAny,           "Alder Lake-N",         ICpuInfo::ARCH_ALDER_LAKE,      ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xB7, 0xB7 }, kAny,           "Raptor Lake",          ICpuInfo::ARCH_RAPTOR_LAKE,     ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xBA, 0xBA }, kAny,           "Raptor Lake",          ICpuInfo::ARCH_RAPTOR_LAKE,     ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xBF, 0xBF }, kAny,           "Raptor Lake",          ICpuInfo::ARCH_RAPTOR_LAKE,     ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xC5, 0xC6 }, kAny,           "Arrow Lake",           ICpuInfo::ARCH_ARROW_LAKE,      ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0x8F, 0x8F }, kAny,           "Sapphire Rapids",      ICpuInfo::ARCH_SAPPHIRE_RAPIDS, ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xCF, 0xCF }, kAny,           "Emerald Rapids",       ICpuInfo::ARCH_EMERALD_RAPIDS,  ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    { 0x06, 0x06 }, { 0xAD, 0xAE }, kAny,           "Granite Rapids",       ICpuInfo::ARCH_GRANITE_RAPIDS,  ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+    { INTEL,    kAny,           kAny,           kAny,           "Intel",                ICpuInfo::ARCH_UNKNOWN,         ICpuInfo::MSR_MOD_INTEL,                Assembly::INTEL,    AVX2_NO_SMT,  false, false },
+
+    // On ARM the family is the MIDR implementer and the model is the part number.
+    { ARM,      { 0x41, 0x41 }, { 0xD0C, 0xD0C }, kAny,         "Neoverse-N1",          ICpuInfo::ARCH_NEOVERSE_N1,     ICpuInfo::MSR_MOD_NONE,                 Assembly::NONE,     SCALAR,       false, false },
+    { ARM,      { 0x41, 0x41 }, { 0xD40, 0xD40 }, kAny,         "Neoverse-V1",          ICpuInfo::ARCH_NEOVERSE_V1,     ICpuInfo::MSR_MOD_NONE,                 Assembly::NONE,     SCALAR,       false, false },
+    { ARM,      { 0x41, 0x41 }, { 0xD4F, 0xD4F }, kAny,         "Neoverse-V2",          ICpuInfo::ARCH_NEOVERSE_V2,     ICpuInfo::MSR_MOD_NONE,                 Assembly::NONE,     SCALAR,       false, false },
+    { ARM,      { 0xC0, 0xC0 }, { 0xAC3, 0xAC5 }, kAny,         "AmpereOne",            ICpuInfo::ARCH_AMPERE_ONE,      ICpuInfo::MSR_MOD_NONE,                 Assembly::NONE,     SCALAR,       false, false },
+};
+
+
+struct CpuProfileVector
+{
+    ICpuInfo::Vendor vendor;
+    uint32_t family;
+    uint32_t model;
+    uint32_t stepping;
+    const char *name;
+};
+
+
+// CPUID signatures of released parts and the profile each one must get, checked by "--self-test".
+static const CpuProfileVector kVectors[] = {
+    { AMD,      0x17, 0x71, 0x00,   "Zen 2" },                  // Ryzen 3000 (Matisse)
+    { AMD,      0x19, 0x21, 0x00,   "Zen 3 (Vermeer)" },        // Ryzen 5000
+    { AMD,      0x19, 0x01, 0x01,   "Zen 3" },                  // EPYC 7003 (Milan)
+    { AMD,      0x19, 0x11, 0x01,   "Zen 4 (Genoa)" },          // EPYC 9004
+    { AMD,      0x19, 0x61, 0x02,   "Zen 4 (Raphael)" },        // Ryzen 7000
+    { AMD,      0x19, 0x74, 0x01,   "Zen 4" },                  // Ryzen 7040 (Phoenix)
+    { AMD,      0x19, 0x75, 0x02,   "Zen 4" },                  // Ryzen 8040 (Hawk Point)
+    { AMD,      0x19, 0xA0, 0x01,   "Zen 4c" },                 // EPYC 97x4 (Bergamo)
+    { AMD,      0x1A, 0x02, 0x01,   "Zen 5" },                  // EPYC 9005 (Turin)
+    { AMD,      0x1A, 0x11, 0x00,   "Zen 5" },                  // EPYC 9005 (Turin Dense)
+    { AMD,      0x1A, 0x44, 0x00,   "Zen 5" },                  // Ryzen 9000 (Granite Ridge)
+    { INTEL,    0x06, 0x55, 0x07,   "Cascade Lake" },
+    { INTEL,    0x06, 0x97, 0x02,   "Alder Lake" },
+    { INTEL,    0x06, 0xB7, 0x01,   "Raptor Lake" },
+    { INTEL,    0x06, 0x8F, 0x08,   "Sapphire Rapids" },
+    { INTEL,    0x06, 0xCF, 0x02,   "Emerald Rapids" },
+    { INTEL,    0x06, 0xAD, 0x01,   "Granite Rapids" },
+    { ARM,      0x41, 0xD0C, 0x00,  "Neoverse-N1" },            // Graviton2
+    { ARM,      0x41, 0xD40, 0x00,  "Neoverse-V1" },            // Graviton3
+};
+
+
+} // namespace xmrig
+
+
+bool xmrig::CpuProfile::selfTest()
+{
+    size_t failed = 0;
+
+    for (const auto &v : kVectors) {
+        const char *name = find(v.vendor, v.family, v.model, v.stepping).name;
+
+        if (strcmp(name, v.name) != 0) {
+            fprintf(stderr, "CPU profile mismatch: family 0x%X model 0x%X stepping %u is \"%s\", expected \"%s\"\n", v.family, v.model, v.stepping, name, v.name);
+            ++failed;
+        }
+    }
+
+    printf("CPU profiles v%u: %zu of %zu known CPUs match\n", kVersion, sizeof(kVectors) / sizeof(kVectors[0]) - failed, sizeof(kVectors) / sizeof(kVectors[0]));
+
+    return failed == 0;
+}
+
+
+const xmrig::CpuProfile &xmrig::CpuProfile::find(ICpuInfo::Vendor vendor, uint32_t family, uint32_t model, uint32_t stepping)
+{
+    for (const auto &profile : kProfiles) {
+        if (profile.vendor == vendor && profile.family.contains(family) && profile.model.contains(model) && profile.stepping.contains(stepping)) {
+            return profile;
+        }
+    }
+
+    return kUnknown;
+}
+
+
+const xmrig::CpuProfile &xmrig::CpuProfile::unknown()
+{
+    return kUnknown;
+}
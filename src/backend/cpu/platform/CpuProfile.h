@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CPUPROFILE_H
+#define XMRIG_CPUPROFILE_H
+
+
+#include "backend/cpu/interfaces/ICpuInfo.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Microarchitecture profile, selects performance heuristics for a CPU by its identification.
+ * On x86 the key is CPUID family/model/stepping, on ARM the key is MIDR implementer/part/revision.
+ */
+struct CpuProfile
+{
+    enum DatasetInit : uint32_t {
+        DATASET_INIT_SCALAR,            // RandomX dataset init never uses AVX2.
+        DATASET_INIT_AVX2,              // AVX2 dataset init is always faster.
+        DATASET_INIT_AVX2_NO_SMT        // AVX2 dataset init is faster only when SMT is not available.
+    };
+
+    struct Range
+    {
+        inline bool contains(uint32_t value) const { return value >= min && value <= max; }
+
+        uint32_t min;
+        uint32_t max;
+    };
+
+    // Increment if the table changes the settings chosen for an already listed CPU, shown in the summary and as "uarch_version" in the API.
+    static constexpr uint32_t kVersion = 1;
+
+    static bool selfTest();
+    static const CpuProfile &find(ICpuInfo::Vendor vendor, uint32_t family, uint32_t model, uint32_t stepping);
+    static const CpuProfile &unknown();
+
+    ICpuInfo::Vendor vendor;
+    Range family;
+    Range model;
+    Range stepping;
+    const char *name;
+    ICpuInfo::Arch arch;
+    ICpuInfo::MsrMod msrMod;
+    Assembly::Id assembly;
+    DatasetInit datasetInit;
+    bool jccErratum;
+    bool cnHeavyShared;                 // cn-heavy single hash with shared scratchpads (Vermeer, Raphael).
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_CPUPROFILE_H
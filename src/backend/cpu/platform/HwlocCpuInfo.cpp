@@ -164,6 +164,8 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
 
     setThreads(countByType(m_topology, HWLOC_OBJ_PU));
 
+    m_ranking = CoreRanking::read(CoreRanking::kDefaultRoot, m_units);
+
     m_cores     = countByType(m_topology, HWLOC_OBJ_CORE);
     m_nodes     = std::max(hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(m_topology)), 1);
     m_packages  = countByType(m_topology, HWLOC_OBJ_PACKAGE);
@@ -274,6 +276,14 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
 }
 
 
+uint64_t xmrig::HwlocCpuInfo::coreRank(hwloc_obj_t core) const
+{
+    uint64_t rank = 0;
+    findByType(core, HWLOC_OBJ_PU, [this, &rank](hwloc_obj_t pu) { rank = std::max(rank, m_ranking.rank(static_cast<int32_t>(pu->os_index))); });
+
+    return rank;
+}
+
 
 void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const
 {
@@ -374,6 +384,11 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
         return;
     }
 
+    // Not every core gets a thread, take the fastest ones first (preferred cores), hwloc order is kept for equal ranks.
+    if (m_ranking.isValid()) {
+        std::stable_sort(cores.begin(), cores.end(), [this](hwloc_obj_t a, hwloc_obj_t b) { return coreRank(a) > coreRank(b); });
+    }
+
     std::vector<std::pair<int64_t, int32_t>> threads_data;
     threads_data.reserve(cores.size());
 
@@ -0,0 +1,251 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/platform/MemoryTiers.h"
+#include "backend/cpu/Cpu.h"
+
+
+#include <cstring>
+#include <hwloc.h>
+#include <vector>
+
+
+#ifdef XMRIG_OS_LINUX
+#   include "3rdparty/fmt/core.h"
+#   include <fstream>
+#endif
+
+
+#if HWLOC_API_VERSION < 0x00010b00
+#   define HWLOC_OBJ_NUMANODE HWLOC_OBJ_NODE
+#endif
+
+
+namespace xmrig {
+
+
+struct TierNode
+{
+    hwloc_obj_t node;
+    uint64_t bandwidth;     // MiB/s, 0 if unknown.
+    uint64_t latency;       // ns, 0 if unknown.
+    int rank;
+};
+
+
+static inline hwloc_obj_t numa_node(uint32_t nodeId)
+{
+    return hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), nodeId);
+}
+
+
+static inline bool isDRAM(hwloc_obj_t node)
+{
+#   if HWLOC_API_VERSION >= 0x20000
+    return !node->subtype || strcmp(node->subtype, "DRAM") == 0;
+#   else
+    return true;
+#   endif
+}
+
+
+// hwloc 1.x leaves the cpuset of CPU-less nodes empty, hwloc 2.x gives every node the cpuset of its locality, so a CPU-less node
+// there is one with other nodes of a smaller locality inside its cpuset (CXL on the machine), or one sharing its cpuset with a node
+// which takes precedence: DRAM over HBM in flat mode, then the lower index.
+static bool isCpuNode(hwloc_obj_t node)
+{
+    if (hwloc_bitmap_iszero(node->cpuset)) {
+        return false;
+    }
+
+#   if HWLOC_API_VERSION >= 0x20000
+    hwloc_obj_t other = nullptr;
+
+    while ((other = hwloc_get_next_obj_by_type(Cpu::info()->topology(), HWLOC_OBJ_NUMANODE, other)) != nullptr) {
+        if (other == node || hwloc_bitmap_iszero(other->cpuset) || !hwloc_bitmap_isincluded(other->cpuset, node->cpuset)) {
+            continue;
+        }
+
+        if (!hwloc_bitmap_isequal(other->cpuset, node->cpuset)) {
+            return false;
+        }
+
+        if (isDRAM(other) != isDRAM(node) ? isDRAM(other) : other->os_index < node->os_index) {
+            return false;
+        }
+    }
+#   endif
+
+    return true;
+}
+
+
+// Without bandwidth and latency attributes the node subtype set by hwloc is the only hint.
+static int rank(hwloc_obj_t node)
+{
+#   if HWLOC_API_VERSION >= 0x20000
+    const char *subtype = node->subtype;
+#   else
+    const char *subtype = nullptr;
+#   endif
+
+    if (!subtype) {
+        // CPU-less memory without a subtype is usually a CXL expander or PMEM used as RAM.
+        return isCpuNode(node) ? 2 : 1;
+    }
+
+    if (strcmp(subtype, "HBM") == 0 || strcmp(subtype, "MCDRAM") == 0) {
+        return 3;
+    }
+
+    return strcmp(subtype, "DRAM") == 0 ? 2 : 1;
+}
+
+
+static uint64_t attribute(hwloc_obj_t node, hwloc_const_cpuset_t cpuset, int id, const char *name)
+{
+#   if HWLOC_API_VERSION >= 0x00020300
+    hwloc_location initiator{};
+    initiator.type            = HWLOC_LOCATION_TYPE_CPUSET;
+    initiator.location.cpuset = const_cast<hwloc_cpuset_t>(cpuset);
+
+    hwloc_uint64_t value = 0;
+    if (hwloc_memattr_get_value(Cpu::info()->topology(), static_cast<hwloc_memattr_id_t>(id), node, &initiator, 0, &value) == 0 && value > 0) {
+        return value;
+    }
+#   endif
+
+#   ifdef XMRIG_OS_LINUX
+    // Values for the nearest initiators of the node, hwloc ignores them if the initiators are not known.
+    std::ifstream file(fmt::format("/sys/devices/system/node/node{}/access0/initiators/{}", node->os_index, name));
+    uint64_t sysfs = 0;
+
+    if (file >> sysfs) {
+        return sysfs;
+    }
+#   endif
+
+    return 0;
+}
+
+
+static bool isFaster(const TierNode &a, const TierNode &b)
+{
+    if (a.bandwidth && b.bandwidth && a.bandwidth != b.bandwidth) {
+        return a.bandwidth > b.bandwidth;
+    }
+
+    if (a.latency && b.latency && a.latency != b.latency) {
+        return a.latency < b.latency;
+    }
+
+    return a.rank > b.rank;
+}
+
+
+static std::vector<TierNode> localNodes(hwloc_obj_t cpuNode)
+{
+    std::vector<TierNode> out;
+
+#   if HWLOC_API_VERSION >= 0x00020300
+    hwloc_location initiator{};
+    initiator.type            = HWLOC_LOCATION_TYPE_CPUSET;
+    initiator.location.cpuset = cpuNode->cpuset;
+
+    // Memory attached to the package or to the whole machine (CXL, HBM in flat mode) has a larger locality than the node.
+    unsigned count = 0;
+    hwloc_get_local_numanode_objs(Cpu::info()->topology(), &initiator, &count, nullptr, HWLOC_LOCAL_NUMANODE_FLAG_LARGER_LOCALITY);
+
+    std::vector<hwloc_obj_t> nodes(count);
+    if (count > 0 && hwloc_get_local_numanode_objs(Cpu::info()->topology(), &initiator, &count, nodes.data(), HWLOC_LOCAL_NUMANODE_FLAG_LARGER_LOCALITY) == 0) {
+        nodes.resize(count);
+
+        for (auto node : nodes) {
+            out.push_back({ node,
+                            attribute(node, cpuNode->cpuset, HWLOC_MEMATTR_ID_BANDWIDTH, "read_bandwidth"),
+                            attribute(node, cpuNode->cpuset, HWLOC_MEMATTR_ID_LATENCY, "read_latency"),
+                            rank(node) });
+        }
+    }
+#   endif
+
+    if (out.empty()) {
+        out.push_back({ cpuNode, 0, 0, rank(cpuNode) });
+    }
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::MemoryTiers::hasCpus(uint32_t nodeId)
+{
+    auto node = numa_node(nodeId);
+
+    return node && isCpuNode(node);
+}
+
+
+const char *xmrig::MemoryTiers::tier(uint32_t nodeId)
+{
+    auto node = numa_node(nodeId);
+    if (!node) {
+        return "unknown";
+    }
+
+#   if HWLOC_API_VERSION >= 0x20000
+    if (node->subtype) {
+        return node->subtype;
+    }
+#   endif
+
+    return isCpuNode(node) ? "DRAM" : "CPU-less";
+}
+
+
+uint32_t xmrig::MemoryTiers::fast(uint32_t cpuNodeId, size_t size)
+{
+    auto cpuNode = numa_node(cpuNodeId);
+    if (!cpuNode || !isCpuNode(cpuNode)) {
+        return cpuNodeId;
+    }
+
+    TierNode best = { cpuNode, 0, 0, -1 };
+
+    for (const auto &node : localNodes(cpuNode)) {
+#       if HWLOC_API_VERSION >= 0x20000
+        const uint64_t memory = node.node->attr ? node.node->attr->numanode.local_memory : 0;
+#       else
+        const uint64_t memory = node.node->memory.local_memory;
+#       endif
+
+        // Small HBM nodes (SNC modes) can't hold the data, a failed allocation is worse than a slower tier.
+        if (memory > 0 && memory < size) {
+            continue;
+        }
+
+        if (best.rank < 0 || isFaster(node, best)) {
+            best = node;
+        }
+    }
+
+    return best.node->os_index;
+}
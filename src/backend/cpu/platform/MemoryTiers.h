@@ -0,0 +1,47 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_MEMORYTIERS_H
+#define XMRIG_MEMORYTIERS_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * Picks NUMA nodes by memory tier (HBM, DRAM, CXL, PMEM) for data used by the CPUs of a NUMA node.
+ * Uses hwloc bandwidth and latency attributes, on Linux also the HMAT values in /sys/devices/system/node/nodeN/access0.
+ */
+class MemoryTiers
+{
+public:
+    static bool hasCpus(uint32_t nodeId);
+    static const char *tier(uint32_t nodeId);
+    static uint32_t fast(uint32_t cpuNodeId, size_t size);
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_MEMORYTIERS_H
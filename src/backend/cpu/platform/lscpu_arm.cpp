@@ -378,6 +378,20 @@ static bool arm_cpu_decode(lscpu_desc *desc)
 }
 
 
+bool cpu_id_arm(uint32_t &implementer, uint32_t &part)
+{
+    lscpu_desc desc;
+    if (!read_basicinfo(&desc) || strncmp(desc.vendor, "0x", 2) != 0 || strncmp(desc.model, "0x", 2) != 0) {
+        return false;
+    }
+
+    implementer = strtoul(desc.vendor, nullptr, 0);
+    part        = strtoul(desc.model, nullptr, 0);
+
+    return true;
+}
+
+
 String cpu_name_arm()
 {
     lscpu_desc desc;
@@ -20,6 +20,7 @@
 
 
 #include "base/api/Api.h"
+#include "3rdparty/fmt/core.h"
 #include "base/api/interfaces/IApiListener.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
@@ -28,6 +29,7 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Base.h"
+#include "base/net/http/HttpData.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -104,9 +106,39 @@ xmrig::Api::~Api()
 
 void xmrig::Api::request(const HttpData &req)
 {
+    if (req.method != IApiRequest::METHOD_GET) {
+        HttpApiRequest request(req, m_base->config()->http().isRestricted());
+
+        return exec(request);
+    }
+
+    // GET responses are cached until the next generation, so repeated polls cost no JSON rebuild.
+    const std::string etag     = fmt::format("\"{:x}-{:x}\"", m_timestamp, m_generation);
+    const std::string resource = HttpApiRequest::resource(req.url);
+    const auto match           = req.headers.find("if-none-match");
+    const auto encoding        = req.headers.find("accept-encoding");
+    const bool notModified     = match != req.headers.end() && match->second.find(etag) != std::string::npos;
+    const bool gzip            = encoding != req.headers.end() && encoding->second.find("gzip") != std::string::npos;
+
+    const auto it = m_cache.find(resource);
+    if (it != m_cache.end()) {
+        HttpApiResponse response(req.id());
+        response.setCache(it->second, etag, notModified, gzip);
+
+        return response.endCached();
+    }
+
+    auto cached = std::make_shared<HttpApiResponse::Cached>();
+
     HttpApiRequest request(req, m_base->config()->http().isRestricted());
+    request.setCache(cached, etag, notModified, gzip);
 
     exec(request);
+
+    // Only successful responses fill the body, so only known endpoints are cached, the limit is just a safety cap.
+    if (!cached->body.empty() && m_cache.size() < kMaxCacheEntries) {
+        m_cache.emplace(resource, std::move(cached));
+    }
 }
 
 
@@ -140,6 +172,8 @@ void xmrig::Api::stop()
 
 void xmrig::Api::tick()
 {
+    invalidate();
+
 #   ifdef XMRIG_FEATURE_HTTP
     if (!m_httpd || !m_base->config()->http().isEnabled() || m_httpd->isBound()) {
         return;
@@ -157,6 +191,8 @@ void xmrig::Api::tick()
 
 void xmrig::Api::onConfigChanged(Config *config, Config *previousConfig)
 {
+    invalidate();
+
     if (config->apiId() != previousConfig->apiId()) {
         genId(config->apiId());
     }
@@ -20,10 +20,14 @@
 #define XMRIG_API_H
 
 
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 
 #include "base/kernel/interfaces/IBaseListener.h"
+#include "base/net/http/HttpApiResponse.h"
 #include "base/tools/String.h"
 
 
@@ -49,6 +53,7 @@ public:
     inline const char *id() const                   { return m_id; }
     inline const char *workerId() const             { return m_workerId; }
     inline void addListener(IApiListener *listener) { m_listeners.push_back(listener); }
+    inline void invalidate()                        { m_generation++; m_cache.clear(); }
 
     void request(const HttpData &req);
     void start();
@@ -59,6 +64,8 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
 
 private:
+    constexpr static size_t kMaxCacheEntries = 32;
+
     void exec(IApiRequest &request);
     void genId(const String &id);
     void genWorkerId(const String &id);
@@ -66,10 +73,12 @@ private:
     Base *m_base;
     char m_id[32]{};
     const uint64_t m_timestamp;
-    Httpd *m_httpd  = nullptr;
+    Httpd *m_httpd          = nullptr;
+    std::map<std::string, std::shared_ptr<HttpApiResponse::Cached>> m_cache;
     std::vector<IApiListener *> m_listeners;
     String m_workerId;
-    uint8_t m_ticks = 0;
+    uint64_t m_generation   = 0;
+    uint8_t m_ticks         = 0;
 };
 
 
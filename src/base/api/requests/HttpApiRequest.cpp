@@ -65,7 +65,7 @@ xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
     ApiRequest(SOURCE_HTTP, restricted),
     m_req(req),
     m_res(req.id()),
-    m_url(req.url.c_str())
+    m_url(resource(req.url).c_str())
 {
     if (method() == METHOD_GET) {
         if (url() == "/1/summary" || url() == "/2/summary" || url() == "/api.json") {
@@ -103,6 +103,13 @@ xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
 }
 
 
+std::string xmrig::HttpApiRequest::resource(const std::string &url)
+{
+    // Endpoints take no query parameters, the query is ignored so it can't create extra cache entries.
+    return url.substr(0, url.find_first_of("?#"));
+}
+
+
 bool xmrig::HttpApiRequest::accept()
 {
     using namespace rapidjson;
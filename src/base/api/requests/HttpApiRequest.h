@@ -37,6 +37,10 @@ class HttpApiRequest : public ApiRequest
 public:
     HttpApiRequest(const HttpData &req, bool restricted);
 
+    static std::string resource(const std::string &url);
+
+    inline void setCache(const std::shared_ptr<HttpApiResponse::Cached> &cached, const std::string &etag, bool notModified, bool gzip) { m_res.setCache(cached, etag, notModified, gzip); }
+
 protected:
     inline bool hasParseError() const override           { return m_parsed == 2; }
     inline const String &url() const override            { return m_url; }
@@ -52,6 +52,7 @@ set(HEADERS_BASE
     src/base/net/http/Http.h
     src/base/net/http/HttpListener.h
     src/base/net/stratum/BaseClient.h
+    src/base/net/stratum/BinaryClient.h
     src/base/net/stratum/Client.h
     src/base/net/stratum/Job.h
     src/base/net/stratum/NetworkState.h
@@ -120,6 +121,7 @@ set(SOURCES_BASE
     src/base/net/dns/DnsUvBackend.cpp
     src/base/net/http/Http.cpp
     src/base/net/stratum/BaseClient.cpp
+    src/base/net/stratum/BinaryClient.cpp
     src/base/net/stratum/Client.cpp
     src/base/net/stratum/Job.cpp
     src/base/net/stratum/NetworkState.cpp
@@ -193,14 +195,17 @@ if (WITH_HTTP)
         src/base/kernel/interfaces/IHttpListener.h
         src/base/kernel/interfaces/IJsonReader.h
         src/base/kernel/interfaces/ITcpServerListener.h
+        src/base/kernel/interfaces/IZmqListener.h
         src/base/net/http/Fetch.h
         src/base/net/http/HttpApiResponse.h
         src/base/net/http/HttpClient.h
         src/base/net/http/HttpContext.h
         src/base/net/http/HttpData.h
         src/base/net/http/HttpResponse.h
+        src/base/net/stratum/DaemonBroadcast.h
         src/base/net/stratum/DaemonClient.h
         src/base/net/stratum/SelfSelectClient.h
+        src/base/net/stratum/ZmqSubscriber.h
         src/base/net/tools/TcpServer.h
         )
 
@@ -219,8 +224,10 @@ if (WITH_HTTP)
         src/base/net/http/HttpData.cpp
         src/base/net/http/HttpListener.cpp
         src/base/net/http/HttpResponse.cpp
+        src/base/net/stratum/DaemonBroadcast.cpp
         src/base/net/stratum/DaemonClient.cpp
         src/base/net/stratum/SelfSelectClient.cpp
+        src/base/net/stratum/ZmqSubscriber.cpp
         src/base/net/tools/TcpServer.cpp
         )
 
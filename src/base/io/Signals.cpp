@@ -25,7 +25,7 @@
 
 
 #ifdef SIGUSR1
-static const int signums[xmrig::Signals::kSignalsCount] = { SIGHUP, SIGINT, SIGTERM, SIGUSR1 };
+static const int signums[xmrig::Signals::kSignalsCount] = { SIGHUP, SIGINT, SIGTERM, SIGUSR1, SIGUSR2 };
 #else
 static const int signums[xmrig::Signals::kSignalsCount] = { SIGHUP, SIGINT, SIGTERM };
 #endif
@@ -78,6 +78,10 @@ void xmrig::Signals::onSignal(uv_signal_t *handle, int signum)
     case SIGUSR1:
         LOG_V5("%s " WHITE_BOLD("SIGUSR1 received"), Tags::signal());
         break;
+
+    case SIGUSR2:
+        LOG_WARN("%s " YELLOW("SIGUSR2 received, upgrading"), Tags::signal());
+        break;
 #   endif
 
     default:
@@ -42,7 +42,7 @@ public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Signals)
 
 #   ifdef SIGUSR1
-    constexpr static const size_t kSignalsCount = 4;
+    constexpr static const size_t kSignalsCount = 5;
 #   else
     constexpr static const size_t kSignalsCount = 3;
 #   endif
@@ -41,11 +41,17 @@
 #endif
 
 #include "base/kernel/Entry.h"
+#include "backend/cpu/platform/CpuProfile.h"
 #include "base/kernel/Process.h"
 #include "core/config/usage.h"
 #include "version.h"
 
 
+#ifdef XMRIG_OS_UNIX
+#   include "core/stats/StatsSegment.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -145,6 +151,10 @@ xmrig::Entry::Id xmrig::Entry::get(const Process &process)
          return Version;
     }
 
+    if (args.hasArg("--self-test")) {
+        return SelfTest;
+    }
+
 #   ifdef XMRIG_FEATURE_HWLOC
     if (args.hasArg("--export-topology")) {
         return Topo;
@@ -157,6 +167,12 @@ xmrig::Entry::Id xmrig::Entry::get(const Process &process)
     }
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    if (args.hasArg("--stats-read")) {
+        return Stats;
+    }
+#   endif
+
     return Default;
 }
 
@@ -171,6 +187,9 @@ int xmrig::Entry::exec(const Process &process, Id id)
     case Version:
         return showVersion();
 
+    case SelfTest:
+        return CpuProfile::selfTest() ? 0 : 1;
+
 #   ifdef XMRIG_FEATURE_HWLOC
     case Topo:
         return exportTopology(process);
@@ -184,6 +203,11 @@ int xmrig::Entry::exec(const Process &process, Id id)
         return 0;
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    case Stats:
+        return StatsSegment::print(process.arguments().value("--stats-read"));
+#   endif
+
     default:
         break;
     }
@@ -40,7 +40,9 @@ public:
         Usage,
         Version,
         Topo,
-        Platforms
+        Platforms,
+        Stats,
+        SelfTest
     };
 
     static Id get(const Process &process);
@@ -32,6 +32,12 @@ namespace xmrig {
 class Platform
 {
 public:
+    enum SchedProfile {
+        SCHED_PROFILE_DEFAULT,  // threads started by the event loop thread: kernel default timer slack
+        SCHED_PROFILE_COMPUTE,  // hashing threads: batch scheduling, coarse timers
+        SCHED_PROFILE_LATENCY   // event loop thread: precise timers
+    };
+
     static inline bool trySetThreadAffinity(int64_t cpu_id)
     {
         if (cpu_id < 0) {
@@ -45,6 +51,7 @@ public:
     static void init(const char *userAgent);
     static void setProcessPriority(int priority);
     static void setThreadPriority(int priority);
+    static void setThreadSchedProfile(SchedProfile profile);
 
     static inline bool isUserActive(uint64_t ms)    { return idleTime() < ms; }
     static inline const String &userAgent()         { return m_userAgent; }
@@ -103,6 +103,11 @@ void xmrig::Platform::setThreadPriority(int priority)
 }
 
 
+void xmrig::Platform::setThreadSchedProfile(SchedProfile)
+{
+}
+
+
 bool xmrig::Platform::isOnBatteryPower()
 {
     return IOPSGetTimeRemainingEstimate() != kIOPSTimeRemainingUnlimited;
@@ -26,6 +26,11 @@
 #endif
 
 
+#ifdef XMRIG_OS_LINUX
+#   include <sys/prctl.h>
+#endif
+
+
 #include <pthread.h>
 #include <sched.h>
 #include <stdio.h>
@@ -157,6 +162,34 @@ void xmrig::Platform::setThreadPriority(int priority)
 }
 
 
+void xmrig::Platform::setThreadSchedProfile(SchedProfile profile)
+{
+#   ifdef XMRIG_OS_LINUX
+    // New threads inherit the timer slack of the creating thread, the kernel default is 50 us.
+    if (profile == SCHED_PROFILE_DEFAULT) {
+        prctl(PR_SET_TIMERSLACK, 50000UL);
+
+        return;
+    }
+
+    if (profile == SCHED_PROFILE_LATENCY) {
+        prctl(PR_SET_TIMERSLACK, 1UL);
+
+        return;
+    }
+
+    // Mining threads never wait on timers, except when paused, a few milliseconds of slack there are not noticeable.
+    prctl(PR_SET_TIMERSLACK, 5000000UL);
+
+    // SCHED_IDLE set by priority 0 is kept.
+    if (sched_getscheduler(0) == SCHED_OTHER) {
+        sched_param param{};
+        sched_setscheduler(0, SCHED_BATCH, &param);
+    }
+#   endif
+}
+
+
 bool xmrig::Platform::isOnBatteryPower()
 {
     for (int i = 0; i <= 1; ++i) {
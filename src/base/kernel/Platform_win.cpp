@@ -159,6 +159,11 @@ void xmrig::Platform::setThreadPriority(int priority)
 }
 
 
+void xmrig::Platform::setThreadSchedProfile(SchedProfile)
+{
+}
+
+
 bool xmrig::Platform::isOnBatteryPower()
 {
     SYSTEM_POWER_STATUS st;
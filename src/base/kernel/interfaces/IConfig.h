@@ -89,6 +89,7 @@ public:
         HugePagesJitKey      = 1057,
         RotationKey          = 1058,
         DaemonJobTimeoutKey  = 1059,
+        StatsShmKey          = 1061,
 
         // xmrig common
         CPUPriorityKey       = 1021,
@@ -114,6 +115,7 @@ public:
         YieldKey             = 1030,
         Argon2ImplKey        = 1039,
         RandomXCacheQoSKey   = 1040,
+        RandomXAutotuneKey   = 1060,
 
         // xmrig amd
         OclPlatformKey       = 1400,
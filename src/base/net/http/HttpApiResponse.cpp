@@ -23,11 +23,43 @@
 #include "base/net/http/HttpData.h"
 
 
+#ifdef XMRIG_FEATURE_ZLIB
+#   include <zlib.h>
+#endif
+
+
 namespace xmrig {
 
 static const char *kError  = "error";
 static const char *kStatus = "status";
 
+
+#ifdef XMRIG_FEATURE_ZLIB
+static std::string compress(const std::string &data)
+{
+    z_stream stream{};
+
+    // 15 + 16 window bits write a gzip header and trailer instead of raw zlib.
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return {};
+    }
+
+    std::string out(deflateBound(&stream, data.size()), '\0');
+
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in  = static_cast<uInt>(data.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&out[0]);
+    stream.avail_out = static_cast<uInt>(out.size());
+
+    const int rc = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return rc == Z_STREAM_END ? out : std::string();
+}
+#endif
+
+
 } // namespace xmrig
 
 
@@ -50,10 +82,6 @@ void xmrig::HttpApiResponse::end()
 {
     using namespace rapidjson;
 
-    setHeader("Access-Control-Allow-Origin", "*");
-    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
-    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
-
     if (statusCode() >= 400) {
         if (!m_doc.HasMember(kStatus)) {
             m_doc.AddMember(StringRef(kStatus), statusCode(), m_doc.GetAllocator());
@@ -65,11 +93,11 @@ void xmrig::HttpApiResponse::end()
     }
 
     if (m_doc.IsObject() && m_doc.ObjectEmpty()) {
+        setHeaders();
+
         return HttpResponse::end();
     }
 
-    setHeader(HttpData::kContentType, HttpData::kApplicationJson);
-
     StringBuffer buffer(nullptr, 4096);
     PrettyWriter<StringBuffer> writer(buffer);
     writer.SetMaxDecimalPlaces(10);
@@ -77,5 +105,71 @@ void xmrig::HttpApiResponse::end()
 
     m_doc.Accept(writer);
 
+    if (m_cached && statusCode() == 200) {
+        m_cached->body.assign(buffer.GetString(), buffer.GetSize());
+
+        return endCached();
+    }
+
+    setHeaders();
+    setHeader(HttpData::kContentType, HttpData::kApplicationJson);
+
     HttpResponse::end(buffer.GetString(), buffer.GetSize());
 }
+
+
+void xmrig::HttpApiResponse::setCache(const std::shared_ptr<Cached> &cached, const std::string &etag, bool notModified, bool gzip)
+{
+    m_cached      = cached;
+    m_etag        = etag;
+    m_notModified = notModified;
+    m_gzip        = gzip;
+}
+
+
+void xmrig::HttpApiResponse::endCached()
+{
+    // The ETag matches the current generation, so a fresh body is the same as the one the client already has.
+    if (m_notModified) {
+        setStatus(304);
+        setHeaders();
+
+        return HttpResponse::end();
+    }
+
+#   ifdef XMRIG_FEATURE_ZLIB
+    if (m_gzip && m_cached->body.size() >= kMinGzipSize) {
+        if (m_cached->gzip.empty()) {
+            m_cached->gzip = compress(m_cached->body);
+        }
+
+        if (!m_cached->gzip.empty()) {
+            setHeaders(true);
+            setHeader(HttpData::kContentType, HttpData::kApplicationJson);
+            setHeader("Content-Encoding", "gzip");
+
+            return HttpResponse::end(m_cached->gzip.data(), m_cached->gzip.size());
+        }
+    }
+#   endif
+
+    setHeaders();
+    setHeader(HttpData::kContentType, HttpData::kApplicationJson);
+
+    HttpResponse::end(m_cached->body.data(), m_cached->body.size());
+}
+
+
+void xmrig::HttpApiResponse::setHeaders(bool gzip)
+{
+    setHeader("Access-Control-Allow-Origin", "*");
+    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
+    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
+
+    if (!m_etag.empty() && (statusCode() == 200 || statusCode() == 304)) {
+        // Compressed body is not byte-identical, the tag becomes weak like nginx does for gzip.
+        setHeader("ETag", gzip ? "W/" + m_etag : m_etag);
+        setHeader("Cache-Control", "no-cache");
+        setHeader("Vary", "Accept-Encoding");
+    }
+}
@@ -25,21 +25,41 @@
 #include "base/net/http/HttpResponse.h"
 
 
+#include <memory>
+
+
 namespace xmrig {
 
 
 class HttpApiResponse : public HttpResponse
 {
 public:
+    // Serialized GET body shared by all responses of one API generation, the gzip copy is made on first use.
+    struct Cached
+    {
+        std::string body;
+        std::string gzip;
+    };
+
+    constexpr static size_t kMinGzipSize = 1024;
+
     HttpApiResponse(uint64_t id);
     HttpApiResponse(uint64_t id, int status);
 
-    inline rapidjson::Document &doc() { return m_doc; }
+    inline rapidjson::Document &doc()               { return m_doc; }
 
     void end();
+    void endCached();
+    void setCache(const std::shared_ptr<Cached> &cached, const std::string &etag, bool notModified, bool gzip);
 
 private:
+    void setHeaders(bool gzip = false);
+
+    bool m_gzip         = false;
+    bool m_notModified  = false;
     rapidjson::Document m_doc;
+    std::shared_ptr<Cached> m_cached;
+    std::string m_etag;
 };
 
 
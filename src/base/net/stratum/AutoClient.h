@@ -38,7 +38,8 @@ public:
     ~AutoClient() override = default;
 
 protected:
-    inline void login() override    { Client::login(); }
+    inline bool requestJob() override   { return m_mode == DEFAULT_MODE && Client::requestJob(); } // NOLINT(bugprone-parent-virtual-call)
+    inline void login() override        { Client::login(); }
 
     bool handleResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error) override;
     bool parseLogin(const rapidjson::Value &result, int *code) override;
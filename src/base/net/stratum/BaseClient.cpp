@@ -26,10 +26,14 @@
 #include "base/net/stratum/SubmitResult.h"
 
 
+#include <uv.h>
+
+
 namespace xmrig {
 
 
 int64_t BaseClient::m_sequence = 1;
+uint64_t BaseClient::m_readTime = 0;
 
 
 } /* namespace xmrig */
@@ -42,6 +46,18 @@ xmrig::BaseClient::BaseClient(int id, IClientListener *listener) :
 }
 
 
+xmrig::BaseClient::ReadStamp::ReadStamp()
+{
+    m_readTime = uv_hrtime();
+}
+
+
+xmrig::BaseClient::ReadStamp::~ReadStamp()
+{
+    m_readTime = 0;
+}
+
+
 void xmrig::BaseClient::setPool(const Pool &pool)
 {
     if (!pool.isValid()) {
@@ -41,6 +41,17 @@ class BaseClient : public IClient
 public:
     BaseClient(int id, IClientListener *listener);
 
+    // Jobs reach the listener synchronously from the read callback, so the stamp is their receive time.
+    class ReadStamp
+    {
+    public:
+        ReadStamp();
+        ~ReadStamp();
+    };
+
+    // uv_hrtime() at the start of the network read callback in progress, 0 outside of it.
+    static inline uint64_t readTime()                          { return m_readTime; }
+
 protected:
     inline bool isEnabled() const override                     { return m_enabled; }
     inline const char *tag() const override                    { return m_tag.c_str(); }
@@ -49,6 +60,7 @@ protected:
     inline const String &ip() const override                   { return m_ip; }
     inline int id() const override                             { return m_id; }
     inline int64_t sequence() const override                   { return m_sequence; }
+    inline uint64_t rtt() const override                       { return m_rtt; }
     inline void setAlgo(const Algorithm &algo) override        { m_pool.setAlgo(algo); }
     inline void setEnabled(bool enabled) override              { m_enabled = enabled; }
     inline void setProxy(const ProxyUrl &proxy) override       { m_pool.setProxy(proxy); }
@@ -97,8 +109,10 @@ protected:
     String m_rigId;
     String m_user;
     uint64_t m_retryPause           = 5000;
+    uint64_t m_rtt                  = 0;
 
     static int64_t m_sequence;
+    static uint64_t m_readTime;
 
 private:
     bool m_enabled = true;
@@ -0,0 +1,507 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/BinaryClient.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/IClientListener.h"
+#include "net/JobResult.h"
+
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+
+namespace xmrig {
+
+
+class BinaryClient::Reader
+{
+public:
+    inline Reader(const uint8_t *data, size_t size) : m_data(data), m_end(data + size) {}
+
+    inline bool bytes8(const uint8_t **data, size_t *size)  { uint8_t s = 0; return read(s) && bytes(data, size, s); }
+    inline bool bytes16(const uint8_t **data, size_t *size) { uint16_t s = 0; return read(s) && bytes(data, size, s); }
+
+    template<typename T>
+    inline bool read(T &value)
+    {
+        static_assert(std::is_unsigned<T>::value, "wire integers are unsigned");
+
+        if (static_cast<size_t>(m_end - m_data) < sizeof(T)) {
+            return false;
+        }
+
+        // Little-endian regardless of the host byte order.
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(static_cast<T>(m_data[i]) << (8 * i));
+        }
+
+        m_data += sizeof(T);
+
+        return true;
+    }
+
+    bool str(std::string &value)
+    {
+        const uint8_t *data = nullptr;
+        size_t size         = 0;
+
+        if (!bytes8(&data, &size)) {
+            return false;
+        }
+
+        value.assign(reinterpret_cast<const char *>(data), size);
+
+        return true;
+    }
+
+private:
+    bool bytes(const uint8_t **data, size_t *size, size_t required)
+    {
+        if (static_cast<size_t>(m_end - m_data) < required) {
+            return false;
+        }
+
+        *data   = m_data;
+        *size   = required;
+        m_data += required;
+
+        return true;
+    }
+
+    const uint8_t *m_data;
+    const uint8_t *m_end;
+};
+
+
+class BinaryClient::Writer
+{
+public:
+    inline explicit Writer(uint8_t type) : m_data(kHeaderSize, 0) { m_data[2] = type; }
+
+    inline const std::vector<uint8_t> &data() const     { return m_data; }
+    inline void bytes8(const uint8_t *data, size_t size) { write(static_cast<uint8_t>(size)); m_data.insert(m_data.end(), data, data + size); }
+    inline void str(const char *value)                   { bytes8(reinterpret_cast<const uint8_t *>(value ? value : ""), value ? std::min<size_t>(strlen(value), 255) : 0); }
+
+    template<typename T>
+    inline void write(T value)
+    {
+        static_assert(std::is_unsigned<T>::value, "wire integers are unsigned");
+
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            m_data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void finalize()
+    {
+        const size_t size = m_data.size() - kHeaderSize;
+
+        m_data[3] = static_cast<uint8_t>(size);
+        m_data[4] = static_cast<uint8_t>(size >> 8);
+        m_data[5] = static_cast<uint8_t>(size >> 16);
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::BinaryClient::BinaryClient(int id, const char *agent, IClientListener *listener) :
+    Client(id, agent, listener)
+{
+}
+
+
+void xmrig::BinaryClient::connect()
+{
+    if (m_pool.url() != m_configured.url() && m_failures > m_redirectFailures) {
+        LOG_WARN("%s " YELLOW("reconnect target failed, back to %s"), tag(), m_configured.url().data());
+        setPoolUrl(m_configured.url());
+    }
+
+    Client::connect();
+}
+
+
+bool xmrig::BinaryClient::requestJob()
+{
+    // Pools without GetJob support can't provide a job on demand, the caller falls back to reconnect.
+    if (m_state != ConnectedState || rpcId().isNull() || !(m_poolFlags & kFlagGetJob)) {
+        return false;
+    }
+
+    if (!m_jobRequested) {
+        m_jobRequested = true;
+
+        sendMessage(Writer(GetJob));
+    }
+
+    return true;
+}
+
+
+int64_t xmrig::BinaryClient::submit(const JobResult &result)
+{
+#   ifndef XMRIG_PROXY_PROJECT
+    if (result.clientId != rpcId() || rpcId().isNull() || m_state != ConnectedState) {
+        return -1;
+    }
+
+    // Nonce space of the job is exhausted, ask for a new job in-band and reconnect only if the pool can't provide it.
+    if (result.diff == 0) {
+        m_jobExhausted = true;
+
+        if (!requestJob()) {
+            close();
+        }
+
+        return -1;
+    }
+
+    Writer writer(SubmitShares);
+    writer.write(static_cast<uint32_t>(m_sequence));
+    writer.str(result.jobId);
+    writer.write(static_cast<uint32_t>(result.nonce));
+    writer.bytes8(result.result(), 32);
+    writer.bytes8(result.minerSignature(), result.minerSignature() ? 64 : 0);
+    writer.str(result.algorithm.isValid() ? result.algorithm.name() : nullptr);
+
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
+
+    return sendMessage(writer);
+#   else
+    return -1;
+#   endif
+}
+
+
+void xmrig::BinaryClient::login()
+{
+    using namespace rapidjson;
+
+    m_buf.clear();
+    m_results.clear();
+
+    m_jobExhausted = false;
+    m_jobRequested = false;
+    m_poolFlags    = 0;
+
+    // Listener fills supported algorithms exactly as for the JSON login request.
+    Document doc(kObjectType);
+    Value params(kObjectType);
+    m_listener->onLogin(this, doc, params);
+
+    Writer writer(SetupConnection);
+    writer.write(static_cast<uint8_t>(0));
+    writer.write(kProtocolVersion);
+    writer.write(kProtocolVersion);
+    writer.write(static_cast<uint32_t>(0));
+    writer.str(agent());
+    writer.str(m_user);
+    writer.str(m_password);
+    writer.str(m_rigId);
+
+    std::vector<const char *> algorithms;
+    const auto algo = params.FindMember("algo");
+
+    if (algo != params.MemberEnd() && algo->value.IsArray()) {
+        for (const Value &value : algo->value.GetArray()) {
+            if (value.IsString() && algorithms.size() < 255) {
+                algorithms.emplace_back(value.GetString());
+            }
+        }
+    }
+
+    writer.write(static_cast<uint8_t>(algorithms.size()));
+
+    for (const char *name : algorithms) {
+        writer.str(name);
+    }
+
+    sendMessage(writer);
+}
+
+
+void xmrig::BinaryClient::onData(char *data, size_t size)
+{
+    m_buf.insert(m_buf.end(), data, data + size);
+
+    size_t offset = 0;
+
+    while (m_state == ConnectedState && m_buf.size() - offset >= kHeaderSize) {
+        const uint8_t *header = m_buf.data() + offset;
+        const size_t payload  = header[3] | (header[4] << 8) | (header[5] << 16);
+
+        if (payload > kMaxPayloadSize) {
+            if (!isQuiet()) {
+                LOG_ERR("%s " RED("message too large: ") RED_BOLD("%zu") RED(" bytes"), tag(), payload);
+            }
+
+            close();
+            return;
+        }
+
+        if (m_buf.size() - offset < kHeaderSize + payload) {
+            break;
+        }
+
+        startTimeout();
+
+        // Messages from unknown extensions are skipped.
+        if (header[0] == 0 && header[1] == 0) {
+            onMessage(header[2], header + kHeaderSize, payload);
+        }
+
+        offset += kHeaderSize + payload;
+    }
+
+    if (m_state != ConnectedState) {
+        m_buf.clear();
+    }
+    else if (offset) {
+        m_buf.erase(m_buf.begin(), m_buf.begin() + static_cast<ptrdiff_t>(offset));
+    }
+}
+
+
+void xmrig::BinaryClient::ping()
+{
+    startPing();
+    sendMessage(Writer(Ping));
+}
+
+
+void xmrig::BinaryClient::setPool(const Pool &pool)
+{
+    Client::setPool(pool);
+
+    m_configured = m_pool;
+}
+
+
+bool xmrig::BinaryClient::parseJob(Reader &reader, int *code)
+{
+    std::string id;
+    std::string algo;
+    uint64_t height         = 0;
+    uint64_t target         = 0;
+    const uint8_t *seed     = nullptr;
+    const uint8_t *blob     = nullptr;
+    size_t seedSize         = 0;
+    size_t blobSize         = 0;
+
+    if (!reader.str(id) || !reader.str(algo) || !reader.read(height) || !reader.read(target) || !reader.bytes8(&seed, &seedSize) || !reader.bytes16(&blob, &blobSize)) {
+        *code = 2;
+        return false;
+    }
+
+    Job job(m_pool.isNicehash(), m_pool.algorithm(), rpcId());
+
+    if (!job.setId(id.c_str())) {
+        *code = 3;
+        return false;
+    }
+
+    if (!algo.empty()) {
+        job.setAlgorithm(algo.c_str());
+    }
+    else if (m_pool.coin().isValid()) {
+        job.setAlgorithm(m_pool.coin().algorithm(blobSize ? blob[0] : 0));
+    }
+
+    if (!job.setBlob(blob, blobSize)) {
+        *code = 4;
+        return false;
+    }
+
+    if (target == 0) {
+        *code = 5;
+        return false;
+    }
+
+    job.setTarget(target);
+    job.setHeight(height);
+
+    if (!verifyAlgorithm(job.algorithm(), algo.empty() ? nullptr : algo.c_str())) {
+        *code = 6;
+        return false;
+    }
+
+    if (job.algorithm().family() == Algorithm::RANDOM_X && !job.setSeedHash(seed, seedSize)) {
+        *code = 7;
+        return false;
+    }
+
+    if (m_job == job) {
+        return false;
+    }
+
+    m_job          = std::move(job);
+    m_jobExhausted = false;
+    resetStaleJob();
+
+    return true;
+}
+
+
+int64_t xmrig::BinaryClient::sendMessage(const Writer &writer)
+{
+    Writer out(writer);
+    out.finalize();
+
+    return Client::send(reinterpret_cast<const char *>(out.data().data()), out.data().size());
+}
+
+
+void xmrig::BinaryClient::onMessage(uint8_t type, const uint8_t *data, size_t size)
+{
+    Reader reader(data, size);
+
+    switch (type) {
+    case SetupConnectionSuccess: {
+        uint16_t version = 0;
+        uint32_t flags   = 0;
+        std::string id;
+
+        if (!reader.read(version) || !reader.read(flags) || !reader.str(id) || version != kProtocolVersion || id.empty()) {
+            if (!isQuiet()) {
+                LOG_ERR("%s " RED("invalid setup response, protocol version: ") RED_BOLD("%u"), tag(), version);
+            }
+
+            close();
+            return;
+        }
+
+        setRpcId(id.c_str());
+
+        m_poolFlags = flags;
+
+        // Every pool must answer pings, keepalive and RTT sampling do not depend on a negotiated extension.
+        setExtension(EXT_KEEPALIVE, true);
+        startTimeout();
+
+        m_failures = 0;
+        m_listener->onLoginSuccess(this);
+        break;
+    }
+
+    case SetupConnectionError: {
+        uint32_t flags = 0;
+        std::string error;
+        reader.read(flags);
+        reader.str(error);
+
+        if (!isQuiet()) {
+            LOG_ERR("%s " RED("login error: ") RED_BOLD("\"%s\""), tag(), error.c_str());
+        }
+
+        close();
+        break;
+    }
+
+    case NewMiningJob: {
+        m_jobRequested = false;
+
+        int code = -1;
+        if (parseJob(reader, &code)) {
+            m_listener->onJobReceived(this, m_job, rapidjson::Value(rapidjson::kObjectType));
+        }
+        else if (code == -1 && m_jobExhausted) {
+            if (!isQuiet()) {
+                LOG_WARN("%s " YELLOW("nonce space exhausted, reconnect"), tag());
+            }
+
+            close();
+        }
+        else if (code != -1) {
+            if (!isQuiet()) {
+                LOG_ERR("%s " RED("job error code: ") RED_BOLD("%d"), tag(), code);
+            }
+
+            close();
+        }
+        break;
+    }
+
+    case SubmitSharesSuccess:
+    case SubmitSharesError: {
+        uint32_t seq = 0;
+        std::string error;
+
+        if (!reader.read(seq)) {
+            break;
+        }
+
+        if (type == SubmitSharesError) {
+            reader.str(error);
+            if (error.empty()) {
+                error = "rejected";
+            }
+        }
+
+        // Sequence ids are truncated to 32 bits on the wire.
+        for (const auto &kv : m_results) {
+            if (static_cast<uint32_t>(kv.first) == seq) {
+                handleSubmitResponse(kv.first, type == SubmitSharesError ? error.c_str() : nullptr);
+                break;
+            }
+        }
+        break;
+    }
+
+    case Reconnect: {
+        std::string host;
+        uint16_t port = 0;
+
+        if (!reader.str(host) || !reader.read(port)) {
+            break;
+        }
+
+        // Only the port can be changed, a pool must not be able to send miners to another host.
+        if (!host.empty() && m_configured.host() != host.c_str()) {
+            LOG_WARN("%s " YELLOW("reconnect to other host ") YELLOW_BOLD("%s") YELLOW(" refused"), tag(), host.c_str());
+            port = 0;
+        }
+
+        const std::string url = std::string(m_pool.isTLS() ? "binary+ssl://" : "binary+tcp://") + m_configured.host().data() + ":" + std::to_string(port ? port : m_pool.port());
+
+        LOG_WARN("%s " YELLOW("reconnect to %s"), tag(), url.c_str());
+        setPoolUrl(url.c_str());
+
+        // reconnect() counts one failure, a connect after any further failure goes back to the configured URL.
+        m_redirectFailures = m_failures + 1;
+
+        return reconnect();
+    }
+
+    case Pong:
+        pong();
+        break;
+
+    default:
+        LOG_DEBUG("%s unknown message type: 0x%02x (%zu bytes)", tag(), type, size);
+        break;
+    }
+}
@@ -0,0 +1,98 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BINARYCLIENT_H
+#define XMRIG_BINARYCLIENT_H
+
+
+#include "base/net/stratum/Client.h"
+
+
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Compact binary framing for the pool connection, inspired by Stratum V2 message layout.
+ *
+ * Every message has a 6 bytes header: extension type (u16), message type (u8) and payload
+ * length (u24), all integers are little-endian. DNS, SOCKS5, TLS, keepalive and reconnect
+ * logic are shared with the JSON client, only framing and messages are different.
+ * See doc/BINARY.md for the wire format.
+ */
+class BinaryClient : public Client
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(BinaryClient)
+
+    constexpr static size_t kHeaderSize         = 6;
+    constexpr static size_t kMaxPayloadSize     = 64 * 1024;
+    constexpr static uint16_t kProtocolVersion  = 1;
+    constexpr static uint32_t kFlagGetJob       = 1;
+
+    enum MessageType : uint8_t {
+        SetupConnection         = 0x00,
+        SetupConnectionSuccess  = 0x01,
+        SetupConnectionError    = 0x02,
+        NewMiningJob            = 0x15,
+        SubmitShares            = 0x1a,
+        SubmitSharesSuccess     = 0x1c,
+        SubmitSharesError       = 0x1d,
+        GetJob                  = 0x1e,
+        Reconnect               = 0x25,
+        Ping                    = 0x7e,
+        Pong                    = 0x7f
+    };
+
+    BinaryClient(int id, const char *agent, IClientListener *listener);
+    ~BinaryClient() override = default;
+
+protected:
+    inline const char *mode() const override { return "binary"; }
+
+    bool requestJob() override;
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void login() override;
+    void onData(char *data, size_t size) override;
+    void ping() override;
+    void setPool(const Pool &pool) override;
+
+private:
+    class Reader;
+    class Writer;
+
+    bool parseJob(Reader &reader, int *code);
+    int64_t sendMessage(const Writer &writer);
+    void onMessage(uint8_t type, const uint8_t *data, size_t size);
+
+    bool m_jobExhausted = false;
+    bool m_jobRequested = false;
+    int64_t m_redirectFailures = 0;
+    Pool m_configured;
+    std::vector<uint8_t> m_buf;
+    uint32_t m_poolFlags = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_BINARYCLIENT_H */
@@ -17,6 +17,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <iterator>
@@ -26,6 +27,12 @@
 #include <sstream>
 
 
+#ifdef XMRIG_OS_LINUX
+#   include <netinet/in.h>
+#   include <netinet/tcp.h>
+#endif
+
+
 #ifdef XMRIG_FEATURE_TLS
 #   include <openssl/ssl.h>
 #   include <openssl/err.h>
@@ -114,6 +121,22 @@ bool xmrig::Client::isTLS() const
 }
 
 
+bool xmrig::Client::requestJob()
+{
+    if (m_state != ConnectedState || m_rpcId.isNull() || m_getJobUnsupported) {
+        return false;
+    }
+
+    if (m_getJobId < 0) {
+        m_getJobId = m_sequence;
+
+        send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"getjob\",\"params\":{\"id\":\"%s\"}}\n", m_sequence, m_rpcId.data()));
+    }
+
+    return true;
+}
+
+
 const char *xmrig::Client::tlsFingerprint() const
 {
 #   ifdef XMRIG_FEATURE_TLS
@@ -184,8 +207,13 @@ int64_t xmrig::Client::submit(const JobResult &result)
     }
 #   endif
 
+    // Nonce space of the job is exhausted, ask for a new job in-band and reconnect only if the pool can't provide it.
     if (result.diff == 0) {
-        close();
+        m_jobExhausted = true;
+
+        if (!requestJob()) {
+            close();
+        }
 
         return -1;
     }
@@ -290,9 +318,18 @@ void xmrig::Client::tick(uint64_t now)
             LOG_DEBUG_ERR("[%s] timeout", url());
             close();
         }
-        else if (m_keepAlive && now > m_keepAlive) {
+        else if ((m_keepAlive && now > m_keepAlive) || isPingDue(now)) {
             ping();
         }
+        else if (isStale(now)) {
+            if (!isQuiet()) {
+                LOG_WARN("%s " YELLOW("no new job for %" PRIu64 " seconds, reconnect"), tag(), (now - m_jobTime) / 1000);
+            }
+
+            // The connection is still up but the pool has stopped working, skip the remaining retries and fail over right away.
+            m_failures = std::max<int64_t>(m_failures, m_retries - 1);
+            close();
+        }
 
         return;
     }
@@ -354,6 +391,27 @@ bool xmrig::Client::close()
 }
 
 
+bool xmrig::Client::isPingDue(uint64_t now) const
+{
+    const uint64_t interval = static_cast<uint64_t>(m_pool.pingInterval()) * 1000;
+
+    // Pings are sent only to pools that answer them and never overlap, an unanswered ping is caught by the response timeout.
+    return interval && has<EXT_KEEPALIVE>() && m_pingId < 0 && now > m_pingTime + interval;
+}
+
+
+bool xmrig::Client::isStale(uint64_t now) const
+{
+    if (!m_jobTime || m_pool.mode() == Pool::MODE_SELF_SELECT) {
+        return false;
+    }
+
+    const uint64_t timeout = m_pool.staleJobTimeout();
+
+    return timeout && now > m_jobTime + timeout;
+}
+
+
 bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
 {
     if (!params.IsObject()) {
@@ -423,7 +481,9 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
 
     if (m_job != job) {
         m_jobs++;
-        m_job = std::move(job);
+        m_job          = std::move(job);
+        m_jobExhausted = false;
+        resetStaleJob();
         return true;
     }
 
@@ -528,6 +588,25 @@ int xmrig::Client::resolve(const String &host)
 }
 
 
+int64_t xmrig::Client::send(const char *data, size_t size)
+{
+    if (size > kMaxSendBufferSize) {
+        LOG_ERR("%s " RED("send failed: ") RED_BOLD("\"max send buffer size exceeded: %zu\""), tag(), size);
+        close();
+
+        return -1;
+    }
+
+    if (size > m_sendBuf.size()) {
+        m_sendBuf.resize((size / 1024 + 1) * 1024);
+    }
+
+    memcpy(m_sendBuf.data(), data, size);
+
+    return send(size);
+}
+
+
 int64_t xmrig::Client::send(size_t size)
 {
     LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf.data());
@@ -576,6 +655,8 @@ void xmrig::Client::connect(const sockaddr *addr)
     }
 
     uv_tcp_connect(req, m_socket, addr, onConnect);
+
+    setSocketOptions();
 }
 
 
@@ -621,6 +702,9 @@ void xmrig::Client::login()
     using namespace rapidjson;
     m_results.clear();
 
+    m_getJobId     = -1;
+    m_jobExhausted = false;
+
     Document doc(kObjectType);
     auto &allocator = doc.GetAllocator();
 
@@ -789,6 +873,35 @@ void xmrig::Client::parseExtensions(const rapidjson::Value &result)
 }
 
 
+void xmrig::Client::parseGetJob(const rapidjson::Value &result, const rapidjson::Value &error)
+{
+    if (error.IsObject()) {
+        m_getJobUnsupported = true;
+
+        if (!isQuiet()) {
+            LOG_WARN("%s " YELLOW("getjob is not supported: ") YELLOW_BOLD("\"%s\""), tag(), Json::getString(error, "message", ""));
+        }
+    }
+    // Pools without a fresh job return the current one or only a status.
+    else if (result.IsObject() && result.HasMember("job_id") && m_job.id() != Json::getString(result, "job_id")) {
+        int code = -1;
+        if (parseJob(result, &code)) {
+            m_listener->onJobReceived(this, m_job, result);
+
+            return;
+        }
+    }
+
+    if (m_jobExhausted) {
+        if (!isQuiet()) {
+            LOG_WARN("%s " YELLOW("nonce space exhausted, reconnect"), tag());
+        }
+
+        close();
+    }
+}
+
+
 void xmrig::Client::parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &)
 {
     if (strcmp(method, "job") == 0) {
@@ -807,6 +920,16 @@ void xmrig::Client::parseNotification(const char *method, const rapidjson::Value
 
 void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error)
 {
+    if (id == m_pingId) {
+        pong();
+    }
+
+    if (id == m_getJobId) {
+        m_getJobId = -1;
+
+        return parseGetJob(result, error);
+    }
+
     if (handleResponse(id, result, error)) {
         return;
     }
@@ -854,11 +977,17 @@ void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, co
 }
 
 
+void xmrig::Client::onData(char *data, size_t size)
+{
+    m_reader.parse(data, size);
+}
+
+
 void xmrig::Client::ping()
 {
-    send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"keepalived\",\"params\":{\"id\":\"%s\"}}\n", m_sequence, m_rpcId.data()));
+    startPing();
 
-    m_keepAlive = 0;
+    send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"keepalived\",\"params\":{\"id\":\"%s\"}}\n", m_sequence, m_rpcId.data()));
 }
 
 
@@ -907,8 +1036,21 @@ void xmrig::Client::read(ssize_t nread, const uv_buf_t *buf)
     else
 #   endif
     {
-        m_reader.parse(buf->base, size);
+        onData(buf->base, size);
+    }
+}
+
+
+void xmrig::Client::pong()
+{
+    if (m_pingId < 0) {
+        return;
     }
+
+    m_pingId = -1;
+    m_rtt    = Chrono::steadyMSecs() - m_pingTime;
+
+    LOG_DEBUG("[%s] ping %" PRIu64 " ms", url(), m_rtt);
 }
 
 
@@ -950,6 +1092,12 @@ void xmrig::Client::setState(SocketState state)
         m_expire = Chrono::steadyMSecs() + kConnectTimeout;
         break;
 
+    case ConnectedState:
+        m_pingId   = -1;
+        m_pingTime = 0;
+        resetStaleJob();
+        break;
+
     case ReconnectingState:
         m_expire = Chrono::steadyMSecs() + m_retryPause;
         break;
@@ -962,6 +1110,47 @@ void xmrig::Client::setState(SocketState state)
 }
 
 
+void xmrig::Client::resetStaleJob()
+{
+    m_jobTime = Chrono::steadyMSecs();
+}
+
+
+void xmrig::Client::setSocketOptions()
+{
+#   ifdef XMRIG_OS_LINUX
+    const int timeout = m_pool.tcpUserTimeout();
+    uv_os_fd_t fd;
+
+    if (timeout <= 0 || uv_fileno(reinterpret_cast<uv_handle_t *>(m_socket), &fd) != 0) {
+        return;
+    }
+
+    // Unacknowledged data and unanswered keepalive probes both fail the socket after the timeout instead of ~15 minutes of retransmissions.
+    // The keepalive delay passed to uv_tcp_keepalive() before the socket exists is ignored by libuv, so it is set again here.
+    const int ms       = timeout * 1000;
+    const int interval = std::max(timeout / 6, 1);
+    const int count    = 3;
+
+    setsockopt(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, &ms, sizeof(ms));
+
+    if (Platform::hasKeepalive()) {
+        uv_tcp_keepalive(m_socket, 1, static_cast<unsigned int>(std::max(timeout / 2, 1)));
+        setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+        setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count));
+    }
+#   endif
+}
+
+
+void xmrig::Client::startPing()
+{
+    m_pingId    = m_sequence;
+    m_pingTime  = Chrono::steadyMSecs();
+    m_keepAlive = 0;
+}
+
+
 void xmrig::Client::startTimeout()
 {
     m_expire = 0;
@@ -1053,6 +1242,7 @@ void xmrig::Client::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *b
 {
     auto client = getClient(stream->data);
     if (client) {
+        const ReadStamp stamp;
         client->read(nread, buf);
     }
 
@@ -64,6 +64,7 @@ public:
 protected:
     bool disconnect() override;
     bool isTLS() const override;
+    bool requestJob() override;
     const char *tlsFingerprint() const override;
     const char *tlsVersion() const override;
     int64_t send(const rapidjson::Value &obj, Callback callback) override;
@@ -84,39 +85,48 @@ protected:
     inline const char *url() const                                          { return m_pool.url(); }
     inline const String &rpcId() const                                      { return m_rpcId; }
     inline void setRpcId(const char *id)                                    { m_rpcId = id; }
+    inline void setExtension(Extension ext, bool enable) noexcept           { m_extensions.set(ext, enable); }
     inline void setPoolUrl(const char *url)                                 { m_pool.setUrl(url); }
 
     virtual bool parseLogin(const rapidjson::Value &result, int *code);
     virtual void login();
+    virtual void onData(char *data, size_t size);
     virtual void parseNotification(const char* method, const rapidjson::Value& params, const rapidjson::Value& error);
+    virtual void ping();
 
     bool close();
+    bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
+    int64_t send(const char *data, size_t size);
     virtual void onClose();
+    void pong();
+    void reconnect();
+    void resetStaleJob();
+    void startPing();
+    void startTimeout();
 
 private:
     class Socks5;
     class Tls;
 
+    bool isPingDue(uint64_t now) const;
+    bool isStale(uint64_t now) const;
     bool parseJob(const rapidjson::Value &params, int *code);
     bool send(BIO *bio);
-    bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
     bool write(const uv_buf_t &buf);
     int resolve(const String &host);
     int64_t send(size_t size);
     void connect(const sockaddr *addr);
+    void setSocketOptions();
     void handshake();
     void parse(char *line, size_t len);
     void parseExtensions(const rapidjson::Value &result);
+    void parseGetJob(const rapidjson::Value &result, const rapidjson::Value &error);
     void parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
-    void ping();
     void read(ssize_t nread, const uv_buf_t *buf);
-    void reconnect();
     void setState(SocketState state);
-    void startTimeout();
 
     inline SocketState state() const                                { return m_state; }
     inline uv_stream_t *stream() const                              { return reinterpret_cast<uv_stream_t *>(m_socket); }
-    inline void setExtension(Extension ext, bool enable) noexcept   { m_extensions.set(ext, enable); }
     template<Extension ext> inline bool has() const noexcept        { return m_extensions.test(ext); }
 
     static bool isCriticalError(const char *message);
@@ -135,9 +145,15 @@ private:
     std::vector<char> m_tempBuf;
     String m_rpcId;
     Tls *m_tls                  = nullptr;
+    bool m_getJobUnsupported    = false;
+    bool m_jobExhausted         = false;
+    int64_t m_getJobId          = -1;
+    int64_t m_pingId            = -1;
     uint64_t m_expire           = 0;
+    uint64_t m_jobTime          = 0;
     uint64_t m_jobs             = 0;
     uint64_t m_keepAlive        = 0;
+    uint64_t m_pingTime         = 0;
     uintptr_t m_key             = 0;
     uv_tcp_t *m_socket          = nullptr;
 
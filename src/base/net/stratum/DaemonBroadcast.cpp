@@ -0,0 +1,126 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/DaemonBroadcast.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/net/http/Fetch.h"
+#include "base/tools/Chrono.h"
+
+
+#include <cinttypes>
+
+
+namespace xmrig {
+
+
+static const char *kJsonRPC                 = "/json_rpc";
+static constexpr uint64_t kPendingTimeout   = 5 * 60 * 1000;
+
+
+} // namespace xmrig
+
+
+int xmrig::DaemonBroadcast::onResponse(const char *tag, size_t index, int64_t id, const char *error, std::string &reason)
+{
+    auto it = m_pending.find(id);
+    if (it == m_pending.end() || index >= m_endpoints.size()) {
+        return 0;
+    }
+
+    auto &pending     = it->second;
+    const uint64_t ms = Chrono::steadyMSecs() - pending.ts;
+    const char *url   = m_endpoints[index].url().data();
+    int rc            = 0;
+
+    if (error) {
+        LOG_INFO("%s " RED_BOLD("block rejected") " by " CYAN_BOLD("%s") " in " WHITE_BOLD("%" PRIu64 " ms") RED(" \"%s\""), tag, url, ms, error);
+
+        if (pending.error.empty()) {
+            pending.error = error;
+        }
+    }
+    else {
+        LOG_INFO("%s " GREEN_BOLD("block accepted") " by " CYAN_BOLD("%s") " in " WHITE_BOLD("%" PRIu64 " ms"), tag, url, ms);
+
+        if (!pending.done) {
+            pending.done = true;
+            rc           = 1;
+        }
+    }
+
+    if (--pending.remaining == 0) {
+        if (!pending.done) {
+            reason = pending.error;
+            rc     = -1;
+        }
+
+        m_pending.erase(it);
+    }
+
+    return rc;
+}
+
+
+void xmrig::DaemonBroadcast::setEndpoints(const Url &primary, const std::vector<Url> &urls)
+{
+    m_pending.clear();
+    m_endpoints.clear();
+
+    if (urls.empty()) {
+        return;
+    }
+
+    m_endpoints.reserve(urls.size() + 1);
+    m_endpoints.emplace_back(primary);
+    m_endpoints.insert(m_endpoints.end(), urls.begin(), urls.end());
+}
+
+
+void xmrig::DaemonBroadcast::submit(const char *tag, int64_t id, const rapidjson::Value &doc, const std::map<std::string, std::string> &headers, const std::weak_ptr<IHttpListener> &listener, bool quiet)
+{
+    const uint64_t now = Chrono::steadyMSecs();
+
+    // Endpoints which never answered must not keep stale entries forever.
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second.ts <= kPendingTimeout) {
+            ++it;
+            continue;
+        }
+
+        LOG_WARN("%s " YELLOW("block ") YELLOW_BOLD("#%" PRId64) YELLOW(" dropped, %zu of %zu endpoints did not answer in %" PRIu64 " s%s"),
+                 tag, it->first, it->second.remaining, m_endpoints.size(), kPendingTimeout / 1000, it->second.done ? "" : ", result unknown");
+
+        it = m_pending.erase(it);
+    }
+
+    auto &pending       = m_pending[id];
+    pending.remaining   = m_endpoints.size();
+    pending.ts          = now;
+
+    for (size_t i = 1; i < m_endpoints.size(); ++i) {
+        const auto &url = m_endpoints[i];
+
+        FetchRequest req(HTTP_POST, url.host(), url.port(), kJsonRPC, doc, url.isTLS(), quiet);
+        for (const auto &header : headers) {
+            req.headers.insert(header);
+        }
+
+        fetch(tag, std::move(req), listener, static_cast<int>(i), static_cast<uint64_t>(id));
+    }
+}
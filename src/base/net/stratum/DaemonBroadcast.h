@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_DAEMONBROADCAST_H
+#define XMRIG_DAEMONBROADCAST_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/net/stratum/Url.h"
+
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class IHttpListener;
+
+
+/**
+ * Sends found blocks to extra daemons ("daemon-broadcast" pool option) in parallel with the primary one.
+ *
+ * Endpoint 0 is always the primary daemon, extra endpoints are numbered from 1, this number is passed
+ * as HTTP request user type so responses can be routed back. The first acceptance from any endpoint
+ * decides the share result (onResponse returns 1), rejection is reported only after every endpoint
+ * has answered (onResponse returns -1).
+ */
+class DaemonBroadcast
+{
+public:
+    inline bool isEmpty() const                         { return m_endpoints.empty(); }
+    inline bool isPending(int64_t id) const             { return m_pending.count(id) > 0; }
+
+    int onResponse(const char *tag, size_t index, int64_t id, const char *error, std::string &reason);
+    void setEndpoints(const Url &primary, const std::vector<Url> &urls);
+    void submit(const char *tag, int64_t id, const rapidjson::Value &doc, const std::map<std::string, std::string> &headers, const std::weak_ptr<IHttpListener> &listener, bool quiet);
+
+private:
+    struct Pending
+    {
+        bool done           = false;
+        size_t remaining    = 0;
+        std::string error;
+        uint64_t ts         = 0;
+    };
+
+    std::map<int64_t, Pending> m_pending;
+    std::vector<Url> m_endpoints;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_DAEMONBROADCAST_H */
@@ -23,9 +23,6 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <uv.h>
-
-
 #include "base/net/stratum/DaemonClient.h"
 #include "3rdparty/rapidjson/document.h"
 #include "3rdparty/rapidjson/error/en.h"
@@ -33,15 +30,11 @@
 #include "base/io/json/JsonRequest.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IClientListener.h"
-#include "base/kernel/Platform.h"
-#include "base/net/dns/Dns.h"
-#include "base/net/dns/DnsRecords.h"
 #include "base/net/http/Fetch.h"
 #include "base/net/http/HttpData.h"
 #include "base/net/http/HttpListener.h"
 #include "base/net/stratum/SubmitResult.h"
-#include "base/net/tools/NetBuffer.h"
-#include "base/tools/bswap_64.h"
+#include "base/net/stratum/ZmqSubscriber.h"
 #include "base/tools/cryptonote/Signatures.h"
 #include "base/tools/Cvt.h"
 #include "base/tools/Timer.h"
@@ -61,9 +54,6 @@
 namespace xmrig {
 
 
-Storage<DaemonClient> DaemonClient::m_storage;
-
-
 static const char* kBlocktemplateBlob       = "blocktemplate_blob";
 static const char* kBlockhashingBlob        = "blockhashing_blob";
 static const char *kGetHeight               = "/getheight";
@@ -74,12 +64,6 @@ static const char *kJsonRPC                 = "/json_rpc";
 
 static constexpr size_t kBlobReserveSize    = 8;
 
-static const char kZMQGreeting[64] = { static_cast<char>(-1), 0, 0, 0, 0, 0, 0, 0, 0, 127, 3, 0, 'N', 'U', 'L', 'L' };
-static constexpr size_t kZMQGreetingSize1 = 11;
-
-static const char kZMQHandshake[] = "\4\x19\5READY\xbSocket-Type\0\0\0\3SUB";
-static const char kZMQSubscribe[] = "\0\x18\1json-minimal-chain_main";
-
 } // namespace xmrig
 
 
@@ -88,25 +72,20 @@ xmrig::DaemonClient::DaemonClient(int id, IClientListener *listener) :
 {
     m_httpListener  = std::make_shared<HttpListener>(this);
     m_timer         = new Timer(this);
-    m_key           = m_storage.add(this);
+    m_zmq           = new ZmqSubscriber(this);
 }
 
 
 xmrig::DaemonClient::~DaemonClient()
 {
     delete m_timer;
-    delete m_ZMQSocket;
+    delete m_zmq;
 }
 
 
 void xmrig::DaemonClient::deleteLater()
 {
-    if (m_pool.zmq_port() >= 0) {
-        ZMQClose(true);
-    }
-    else {
-        delete this;
-    }
+    delete this;
 }
 
 
@@ -130,12 +109,32 @@ bool xmrig::DaemonClient::isTLS() const
 }
 
 
+bool xmrig::DaemonClient::requestJob()
+{
+    if (m_state != ConnectedState) {
+        return false;
+    }
+
+    if (!rollExtraNonce()) {
+        getBlockTemplate();
+    }
+
+    return true;
+}
+
+
 int64_t xmrig::DaemonClient::submit(const JobResult &result)
 {
     if (result.jobId != m_currentJobId) {
         return -1;
     }
 
+    if (result.diff == 0) {
+        requestJob();
+
+        return -1;
+    }
+
     char *data = m_blocktemplateStr.data();
 
     const size_t sig_offset = m_job.nonceOffset() + m_job.nonceSize();
@@ -186,6 +185,10 @@ int64_t xmrig::DaemonClient::submit(const JobResult &result)
     std::map<std::string, std::string> headers;
     headers.insert({"X-Hash-Difficulty", std::to_string(result.actualDiff())});
 
+    if (!m_broadcast.isEmpty()) {
+        m_broadcast.submit(tag(), m_sequence, doc, headers, m_httpListener, isQuiet());
+    }
+
     return rpcSend(doc, headers);
 }
 
@@ -215,7 +218,7 @@ void xmrig::DaemonClient::connect()
     }
 
     if (m_pool.zmq_port() >= 0) {
-        m_dns = Dns::resolve(m_pool.host(), this);
+        m_zmq->connect(m_pool.host(), m_pool.zmq_port());
     }
     else {
         getBlockTemplate();
@@ -235,6 +238,7 @@ void xmrig::DaemonClient::setPool(const Pool &pool)
     BaseClient::setPool(pool);
 
     m_walletAddress.decode(m_user);
+    m_broadcast.setEndpoints(Url(pool.url()), pool.broadcast());
 
     m_coin = pool.coin().isValid() ?  pool.coin() : m_walletAddress.coin();
 
@@ -246,7 +250,17 @@ void xmrig::DaemonClient::setPool(const Pool &pool)
 
 void xmrig::DaemonClient::onHttpData(const HttpData &data)
 {
+    const ReadStamp stamp;
+
+    if (data.userType > 0) {
+        return onBroadcastResponse(data);
+    }
+
     if (data.status != 200) {
+        if (m_broadcast.isPending(static_cast<int64_t>(data.rpcId))) {
+            onBlockResponse(0, static_cast<int64_t>(data.rpcId), data.statusName());
+        }
+
         return retry();
     }
 
@@ -257,12 +271,19 @@ void xmrig::DaemonClient::onHttpData(const HttpData &data)
     m_tlsFingerprint = data.tlsFingerprint();
 #   endif
 
+    // Parsed in situ: strings are not copied into the document, block templates can be hundreds of KB of hex.
+    std::string body = data.body;
     rapidjson::Document doc;
-    if (doc.Parse(data.body.c_str()).HasParseError()) {
+
+    if (doc.ParseInsitu(&body[0]).HasParseError()) {
         if (!isQuiet()) {
             LOG_ERR("%s " RED("JSON decode failed: ") RED_BOLD("\"%s\""), tag(), rapidjson::GetParseError_En(doc.GetParseError()));
         }
 
+        if (m_broadcast.isPending(static_cast<int64_t>(data.rpcId))) {
+            onBlockResponse(0, static_cast<int64_t>(data.rpcId), rapidjson::GetParseError_En(doc.GetParseError()));
+        }
+
         return retry();
     }
 
@@ -332,44 +353,6 @@ void xmrig::DaemonClient::onTimer(const Timer *)
 }
 
 
-void xmrig::DaemonClient::onResolved(const DnsRecords &records, int status, const char* error)
-{
-    m_dns.reset();
-
-    if (status < 0 && records.isEmpty()) {
-        if (!isQuiet()) {
-            LOG_ERR("%s " RED("DNS error: ") RED_BOLD("\"%s\""), tag(), error);
-        }
-
-        retry();
-        return;
-    }
-
-
-    const auto &record = records.get();
-    m_ip = record.ip();
-
-    auto req = new uv_connect_t;
-    req->data = m_storage.ptr(m_key);
-
-    uv_tcp_t* s = new uv_tcp_t;
-    s->data = m_storage.ptr(m_key);
-
-    uv_tcp_init(uv_default_loop(), s);
-    uv_tcp_nodelay(s, 1);
-
-    if (Platform::hasKeepalive()) {
-        uv_tcp_keepalive(s, 1, 60);
-    }
-
-    if (m_pool.zmq_port() > 0) {
-        delete m_ZMQSocket;
-        m_ZMQSocket = s;
-        uv_tcp_connect(req, s, record.addr(m_pool.zmq_port()), onZMQConnect);
-    }
-}
-
-
 bool xmrig::DaemonClient::isOutdated(uint64_t height, const char *hash) const
 {
     return m_job.height() != height || m_prevHash != hash || Chrono::steadyMSecs() >= m_jobSteadyMs + m_pool.jobTimeout();
@@ -509,7 +492,10 @@ bool xmrig::DaemonClient::parseResponse(int64_t id, const rapidjson::Value &resu
     if (error.IsObject()) {
         const char *message = error["message"].GetString();
 
-        if (!handleSubmitResponse(id, message) && !isQuiet()) {
+        if (m_broadcast.isPending(id)) {
+            onBlockResponse(0, id, message);
+        }
+        else if (!handleSubmitResponse(id, message) && !isQuiet()) {
             LOG_ERR("[%s:%d] error: " RED_BOLD("\"%s\"") RED_S ", code: %d", m_pool.host().data(), m_pool.port(), message, error["code"].GetInt());
         }
 
@@ -532,6 +518,12 @@ bool xmrig::DaemonClient::parseResponse(int64_t id, const rapidjson::Value &resu
         return true;
     }
 
+    if (m_broadcast.isPending(id)) {
+        onBlockResponse(0, id, nullptr);
+
+        return true;
+    }
+
     const char* error_msg = nullptr;
 
     if (handleSubmitResponse(id, error_msg)) {
@@ -546,6 +538,42 @@ bool xmrig::DaemonClient::parseResponse(int64_t id, const rapidjson::Value &resu
 }
 
 
+bool xmrig::DaemonClient::rollExtraNonce()
+{
+    // Signed miner tx (Wownero) must be derived again for a new extra nonce, leave it to the daemon.
+    const size_t size = m_blocktemplate.txExtraNonce().size();
+    if (m_blocktemplate.hasMinerSignature() || size == 0) {
+        return false;
+    }
+
+    String blocktemplate = m_blocktemplateStr;
+    Cvt::toHex(blocktemplate.data() + m_blocktemplate.offset(BlockTemplate::TX_EXTRA_NONCE_OFFSET) * 2, size * 2, Cvt::randomBytes(size).data(), size);
+
+    if (!m_blocktemplate.parse(blocktemplate, m_coin, true)) {
+        m_blocktemplate.parse(m_blocktemplateStr, m_coin);
+
+        return false;
+    }
+
+    Job job(m_job);
+    m_blockhashingblob = Cvt::toHex(m_blocktemplate.generateHashingBlob());
+
+    if (!job.setBlob(m_blockhashingblob)) {
+        return false;
+    }
+
+    m_currentJobId = Cvt::toHex(Cvt::randomBytes(4));
+    job.setId(m_currentJobId);
+
+    m_job              = std::move(job);
+    m_blocktemplateStr = std::move(blocktemplate);
+
+    m_listener->onJobReceived(this, m_job, rapidjson::Value(rapidjson::kObjectType));
+
+    return true;
+}
+
+
 int64_t xmrig::DaemonClient::getBlockTemplate()
 {
     using namespace rapidjson;
@@ -569,12 +597,51 @@ int64_t xmrig::DaemonClient::rpcSend(const rapidjson::Document &doc, const std::
         req.headers.insert(header);
     }
 
-    fetch(tag(), std::move(req), m_httpListener);
+    fetch(tag(), std::move(req), m_httpListener, 0, static_cast<uint64_t>(m_sequence));
 
     return m_sequence++;
 }
 
 
+void xmrig::DaemonClient::onBlockResponse(size_t index, int64_t id, const char *error)
+{
+    std::string reason;
+    const int rc = m_broadcast.onResponse(tag(), index, id, error, reason);
+
+    if (rc > 0) {
+        handleSubmitResponse(id);
+
+        // Don't wait for the next poll or ZMQ notification, the block is already known to the network.
+        getBlockTemplate();
+    }
+    else if (rc < 0) {
+        handleSubmitResponse(id, reason.c_str());
+    }
+}
+
+
+void xmrig::DaemonClient::onBroadcastResponse(const HttpData &data)
+{
+    const char *error = nullptr;
+    rapidjson::Document doc;
+
+    if (data.status != 200) {
+        error = data.statusName();
+    }
+    else if (doc.Parse(data.body.c_str()).HasParseError()) {
+        error = rapidjson::GetParseError_En(doc.GetParseError());
+    }
+    else {
+        const auto &e = Json::getObject(doc, "error");
+        if (e.IsObject()) {
+            error = Json::getString(e, "message", "unknown error");
+        }
+    }
+
+    onBlockResponse(static_cast<size_t>(data.userType), static_cast<int64_t>(data.rpcId), error);
+}
+
+
 void xmrig::DaemonClient::retry()
 {
     m_failures++;
@@ -588,12 +655,7 @@ void xmrig::DaemonClient::retry()
         setState(ConnectingState);
     }
 
-    if ((m_ZMQConnectionState != ZMQ_NOT_CONNECTED) && (m_ZMQConnectionState != ZMQ_DISCONNECTING)) {
-        if (Platform::hasKeepalive()) {
-            uv_tcp_keepalive(m_ZMQSocket, 0, 60);
-        }
-        uv_close(reinterpret_cast<uv_handle_t*>(m_ZMQSocket), onZMQClose);
-    }
+    m_zmq->close();
 
     m_timer->stop();
     m_timer->start(m_retryPause, 0);
@@ -643,258 +705,22 @@ void xmrig::DaemonClient::setState(SocketState state)
 }
 
 
-void xmrig::DaemonClient::onZMQConnect(uv_connect_t* req, int status)
+void xmrig::DaemonClient::onZmqClose(ZmqSubscriber *)
 {
-    DaemonClient* client = getClient(req->data);
-    delete req;
-
-    if (!client) {
-        return;
-    }
-
-    if (status < 0) {
-        LOG_ERR("%s " RED("ZMQ connect error: ") RED_BOLD("\"%s\""), client->tag(), uv_strerror(status));
-        client->retry();
-        return;
-    }
-
-    client->ZMQConnected();
-}
-
-
-void xmrig::DaemonClient::onZMQRead(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf)
-{
-    DaemonClient* client = getClient(stream->data);
-    if (client) {
-        client->ZMQRead(nread, buf);
-    }
-
-    NetBuffer::release(buf);
-}
-
-
-void xmrig::DaemonClient::onZMQClose(uv_handle_t* handle)
-{
-    DaemonClient* client = getClient(handle->data);
-    if (client) {
-#       ifdef APP_DEBUG
-        LOG_DEBUG(CYAN("tcp-zmq://%s:%u") BLACK_BOLD(" disconnected"), client->m_pool.host().data(), client->m_pool.zmq_port());
-#       endif
-        client->m_ZMQConnectionState = ZMQ_NOT_CONNECTED;
-    }
-}
-
-
-void xmrig::DaemonClient::onZMQShutdown(uv_handle_t* handle)
-{
-    DaemonClient* client = getClient(handle->data);
-    if (client) {
-#       ifdef APP_DEBUG
-        LOG_DEBUG(CYAN("tcp-zmq://%s:%u") BLACK_BOLD(" shutdown"), client->m_pool.host().data(), client->m_pool.zmq_port());
-#       endif
-        client->m_ZMQConnectionState = ZMQ_NOT_CONNECTED;
-        m_storage.remove(client->m_key);
-    }
+    retry();
 }
 
 
-void xmrig::DaemonClient::ZMQConnected()
+void xmrig::DaemonClient::onZmqConnected(ZmqSubscriber *subscriber)
 {
-#   ifdef APP_DEBUG
-    LOG_DEBUG(CYAN("tcp-zmq://%s:%u") BLACK_BOLD(" connected"), m_pool.host().data(), m_pool.zmq_port());
-#   endif
-
-    m_ZMQConnectionState = ZMQ_GREETING_1;
-    m_ZMQSendBuf.reserve(256);
-    m_ZMQRecvBuf.reserve(256);
-
-    if (ZMQWrite(kZMQGreeting, kZMQGreetingSize1)) {
-        uv_read_start(reinterpret_cast<uv_stream_t*>(m_ZMQSocket), NetBuffer::onAlloc, onZMQRead);
-    }
-}
-
-
-bool xmrig::DaemonClient::ZMQWrite(const char* data, size_t size)
-{
-    m_ZMQSendBuf.assign(data, data + size);
-
-    uv_buf_t buf;
-    buf.base = m_ZMQSendBuf.data();
-    buf.len = static_cast<uint32_t>(m_ZMQSendBuf.size());
-
-    const int rc = uv_try_write(reinterpret_cast<uv_stream_t*>(m_ZMQSocket), &buf, 1);
-
-    if (static_cast<size_t>(rc) == buf.len) {
-        return true;
-    }
-
-    LOG_ERR("%s " RED("ZMQ write failed, rc = %d"), tag(), rc);
-    ZMQClose();
-    return false;
-}
-
-
-void xmrig::DaemonClient::ZMQRead(ssize_t nread, const uv_buf_t* buf)
-{
-    if (nread <= 0) {
-        LOG_ERR("%s " RED("ZMQ read failed, nread = %" PRId64), tag(), nread);
-        ZMQClose();
-        return;
-    }
-
-    m_ZMQRecvBuf.insert(m_ZMQRecvBuf.end(), buf->base, buf->base + nread);
-
-    do {
-        switch (m_ZMQConnectionState) {
-        case ZMQ_GREETING_1:
-            if (m_ZMQRecvBuf.size() >= kZMQGreetingSize1) {
-                if ((m_ZMQRecvBuf[0] == static_cast<char>(-1)) && (m_ZMQRecvBuf[9] == 127) && (m_ZMQRecvBuf[10] == 3)) {
-                    ZMQWrite(kZMQGreeting + kZMQGreetingSize1, sizeof(kZMQGreeting) - kZMQGreetingSize1);
-                    m_ZMQConnectionState = ZMQ_GREETING_2;
-                    break;
-                }
-
-                LOG_ERR("%s " RED("ZMQ handshake failed: invalid greeting format"), tag());
-                ZMQClose();
-            }
-            return;
-
-        case ZMQ_GREETING_2:
-            if (m_ZMQRecvBuf.size() >= sizeof(kZMQGreeting)) {
-                if (memcmp(m_ZMQRecvBuf.data() + 12, kZMQGreeting + 12, 20) == 0) {
-                    m_ZMQConnectionState = ZMQ_HANDSHAKE;
-                    m_ZMQRecvBuf.erase(m_ZMQRecvBuf.begin(), m_ZMQRecvBuf.begin() + sizeof(kZMQGreeting));
-
-                    ZMQWrite(kZMQHandshake, sizeof(kZMQHandshake) - 1);
-                    break;
-                }
-
-                LOG_ERR("%s " RED("ZMQ handshake failed: invalid greeting format 2"), tag());
-                ZMQClose();
-
-            }
-            return;
-
-        case ZMQ_HANDSHAKE:
-            if (m_ZMQRecvBuf.size() >= 2) {
-                if (m_ZMQRecvBuf[0] != 4) {
-                    LOG_ERR("%s " RED("ZMQ handshake failed: invalid handshake format"), tag());
-                    ZMQClose();
-                    return;
-                }
-
-                const size_t size = static_cast<unsigned char>(m_ZMQRecvBuf[1]);
-                if (size < 18) {
-                    LOG_ERR("%s " RED("ZMQ handshake failed: invalid handshake size"), tag());
-                    ZMQClose();
-                    return;
-                }
-
-                if (m_ZMQRecvBuf.size() < size + 2) {
-                    return;
-                }
-
-                if (memcmp(m_ZMQRecvBuf.data() + 2, kZMQHandshake + 2, 18) != 0) {
-                    LOG_ERR("%s " RED("ZMQ handshake failed: invalid handshake data"), tag());
-                    ZMQClose();
-                    return;
-                }
-
-                ZMQWrite(kZMQSubscribe, sizeof(kZMQSubscribe) - 1);
+    m_ip = subscriber->ip();
 
-                m_ZMQConnectionState = ZMQ_CONNECTED;
-                m_ZMQRecvBuf.erase(m_ZMQRecvBuf.begin(), m_ZMQRecvBuf.begin() + size + 2);
-
-                getBlockTemplate();
-                break;
-            }
-            return;
-
-        case ZMQ_CONNECTED:
-            ZMQParse();
-            return;
-
-        default:
-            return;
-        }
-    } while (true);
+    getBlockTemplate();
 }
 
 
-void xmrig::DaemonClient::ZMQParse()
+void xmrig::DaemonClient::onZmqMessage(ZmqSubscriber *)
 {
-#   ifdef APP_DEBUG
-    std::vector<char> msg;
-#   endif
-
-    size_t msg_size = 0;
-
-    char *data   = m_ZMQRecvBuf.data();
-    size_t avail = m_ZMQRecvBuf.size();
-    bool more    = false;
-
-    do {
-        if (avail < 1) {
-            return;
-        }
-
-        more                 = (data[0] & 1) != 0;
-        const bool long_size = (data[0] & 2) != 0;
-        const bool command   = (data[0] & 4) != 0;
-
-        ++data;
-        --avail;
-
-        uint64_t size = 0;
-        if (long_size)
-        {
-            if (avail < sizeof(uint64_t)) {
-                return;
-            }
-            size = bswap_64(*((uint64_t*)data));
-            data += sizeof(uint64_t);
-            avail -= sizeof(uint64_t);
-        }
-        else
-        {
-            if (avail < sizeof(uint8_t)) {
-                return;
-            }
-            size = static_cast<uint8_t>(*data);
-            ++data;
-            --avail;
-        }
-
-        if (size > 1024U - msg_size)
-        {
-            LOG_ERR("%s " RED("ZMQ message is too large, size = %" PRIu64 " bytes"), tag(), size);
-            ZMQClose();
-            return;
-        }
-
-        if (avail < size) {
-            return;
-        }
-
-        if (!command) {
-#           ifdef APP_DEBUG
-            msg.insert(msg.end(), data, data + size);
-#           endif
-
-            msg_size += size;
-        }
-
-        data += size;
-        avail -= size;
-    } while (more);
-
-    m_ZMQRecvBuf.erase(m_ZMQRecvBuf.begin(), m_ZMQRecvBuf.begin() + (data - m_ZMQRecvBuf.data()));
-
-#   ifdef APP_DEBUG
-    msg.push_back('\0');
-    LOG_DEBUG(CYAN("tcp-zmq://%s:%u") BLACK_BOLD(" read ") CYAN_BOLD("%zu") BLACK_BOLD(" bytes") " %s", m_pool.host().data(), m_pool.zmq_port(), msg.size() - 1, msg.data());
-#   endif
-
     // Clear previous hash and check daemon height to guarantee that xmrig will call get_block_template RPC later
     // We can't call get_block_template directly because daemon is not ready yet
     m_prevHash = nullptr;
@@ -906,28 +732,3 @@ void xmrig::DaemonClient::ZMQParse()
     m_timer->start(t, t);
 }
 
-
-bool xmrig::DaemonClient::ZMQClose(bool shutdown)
-{
-    if ((m_ZMQConnectionState == ZMQ_NOT_CONNECTED) || (m_ZMQConnectionState == ZMQ_DISCONNECTING)) {
-        if (shutdown) {
-            m_storage.remove(m_key);
-        }
-        return false;
-    }
-
-    m_ZMQConnectionState = ZMQ_DISCONNECTING;
-
-    if (uv_is_closing(reinterpret_cast<uv_handle_t*>(m_ZMQSocket)) == 0) {
-        if (Platform::hasKeepalive()) {
-            uv_tcp_keepalive(m_ZMQSocket, 0, 60);
-        }
-        uv_close(reinterpret_cast<uv_handle_t*>(m_ZMQSocket), shutdown ? onZMQShutdown : onZMQClose);
-        if (!shutdown) {
-            retry();
-        }
-        return true;
-    }
-
-    return false;
-}
@@ -21,11 +21,11 @@
 #define XMRIG_DAEMONCLIENT_H
 
 
-#include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/IHttpListener.h"
 #include "base/kernel/interfaces/ITimerListener.h"
+#include "base/kernel/interfaces/IZmqListener.h"
 #include "base/net/stratum/BaseClient.h"
-#include "base/net/tools/Storage.h"
+#include "base/net/stratum/DaemonBroadcast.h"
 #include "base/tools/cryptonote/BlockTemplate.h"
 #include "base/tools/cryptonote/WalletAddress.h"
 
@@ -33,12 +33,6 @@
 #include <memory>
 
 
-using uv_buf_t      = struct uv_buf_t;
-using uv_connect_t  = struct uv_connect_s;
-using uv_handle_t   = struct uv_handle_s;
-using uv_stream_t   = struct uv_stream_s;
-using uv_tcp_t      = struct uv_tcp_s;
-
 #ifdef XMRIG_FEATURE_TLS
 using BIO           = struct bio_st;
 using SSL           = struct ssl_st;
@@ -49,10 +43,10 @@ using SSL_CTX       = struct ssl_ctx_st;
 namespace xmrig {
 
 
-class DnsRequest;
+class ZmqSubscriber;
 
 
-class DaemonClient : public BaseClient, public IDnsListener, public ITimerListener, public IHttpListener
+class DaemonClient : public BaseClient, public ITimerListener, public IHttpListener, public IZmqListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(DaemonClient)
@@ -63,6 +57,7 @@ public:
 protected:
     bool disconnect() override;
     bool isTLS() const override;
+    bool requestJob() override;
     int64_t submit(const JobResult &result) override;
     void connect() override;
     void connect(const Pool &pool) override;
@@ -70,7 +65,9 @@ protected:
 
     void onHttpData(const HttpData &data) override;
     void onTimer(const Timer *timer) override;
-    void onResolved(const DnsRecords &records, int status, const char* error) override;
+    void onZmqClose(ZmqSubscriber *subscriber) override;
+    void onZmqConnected(ZmqSubscriber *subscriber) override;
+    void onZmqMessage(ZmqSubscriber *subscriber) override;
 
     inline bool hasExtension(Extension) const noexcept override         { return false; }
     inline const char *mode() const override                            { return "daemon"; }
@@ -85,8 +82,11 @@ private:
     bool isOutdated(uint64_t height, const char *hash) const;
     bool parseJob(const rapidjson::Value &params, int *code);
     bool parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
+    bool rollExtraNonce();
     int64_t getBlockTemplate();
     int64_t rpcSend(const rapidjson::Document &doc, const std::map<std::string, std::string> &headers = {});
+    void onBlockResponse(size_t index, int64_t id, const char *error);
+    void onBroadcastResponse(const HttpData &data);
     void retry();
     void send(const char *path);
     void setState(SocketState state);
@@ -98,6 +98,7 @@ private:
 
     BlockTemplate m_blocktemplate;
     Coin m_coin;
+    DaemonBroadcast m_broadcast;
     std::shared_ptr<IHttpListener> m_httpListener;
     String m_blockhashingblob;
     String m_blocktemplateRequestHash;
@@ -108,40 +109,9 @@ private:
     String m_tlsFingerprint;
     String m_tlsVersion;
     Timer *m_timer;
+    ZmqSubscriber *m_zmq;
     uint64_t m_blocktemplateRequestHeight = 0;
     WalletAddress m_walletAddress;
-
-private:
-    static inline DaemonClient* getClient(void* data) { return m_storage.get(data); }
-
-    uintptr_t m_key = 0;
-    static Storage<DaemonClient> m_storage;
-
-    static void onZMQConnect(uv_connect_t* req, int status);
-    static void onZMQRead(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf);
-    static void onZMQClose(uv_handle_t* handle);
-    static void onZMQShutdown(uv_handle_t* handle);
-
-    void ZMQConnected();
-    bool ZMQWrite(const char* data, size_t size);
-    void ZMQRead(ssize_t nread, const uv_buf_t* buf);
-    void ZMQParse();
-    bool ZMQClose(bool shutdown = false);
-
-    std::shared_ptr<DnsRequest> m_dns;
-    uv_tcp_t* m_ZMQSocket = nullptr;
-
-    enum {
-        ZMQ_NOT_CONNECTED,
-        ZMQ_GREETING_1,
-        ZMQ_GREETING_2,
-        ZMQ_HANDSHAKE,
-        ZMQ_CONNECTED,
-        ZMQ_DISCONNECTING,
-    } m_ZMQConnectionState = ZMQ_NOT_CONNECTED;
-
-    std::vector<char> m_ZMQSendBuf;
-    std::vector<char> m_ZMQRecvBuf;
 };
 
 
@@ -391,6 +391,7 @@ void xmrig::EthStratumClient::parseNotification(const char *method, const rapidj
 
         if (m_job != job) {
             m_job = std::move(job);
+            resetStaleJob();
 
             // Workaround for nanopool.org, mining.notify received before mining.authorize response.
             if (!m_authorized) {
@@ -94,6 +94,29 @@ bool xmrig::Job::setBlob(const char *blob)
 }
 
 
+bool xmrig::Job::setBlob(const uint8_t *blob, size_t size)
+{
+    const size_t minSize = nonceOffset() + nonceSize();
+    if (!blob || size < minSize || size >= sizeof(m_blob)) {
+        return false;
+    }
+
+    memcpy(m_blob, blob, size);
+
+    if (readUnaligned(nonce()) != 0 && !m_nicehash) {
+        m_nicehash = true;
+    }
+
+#   ifdef XMRIG_PROXY_PROJECT
+    memset(m_rawBlob, 0, sizeof(m_rawBlob));
+    Cvt::toHex(m_rawBlob, sizeof(m_rawBlob), blob, size);
+#   endif
+
+    m_size = size;
+    return true;
+}
+
+
 bool xmrig::Job::setSeedHash(const char *hash)
 {
     if (!hash || (strlen(hash) != kMaxSeedSize * 2)) {
@@ -110,6 +133,22 @@ bool xmrig::Job::setSeedHash(const char *hash)
 }
 
 
+bool xmrig::Job::setSeedHash(const uint8_t *hash, size_t size)
+{
+    if (!hash || size != kMaxSeedSize) {
+        return false;
+    }
+
+    m_seed.assign(hash, hash + size);
+
+#   ifdef XMRIG_PROXY_PROJECT
+    m_rawSeedHash = Cvt::toHex(hash, size);
+#   endif
+
+    return true;
+}
+
+
 bool xmrig::Job::setTarget(const char *target)
 {
     if (!target) {
@@ -141,6 +180,17 @@ bool xmrig::Job::setTarget(const char *target)
 }
 
 
+void xmrig::Job::setTarget(uint64_t target)
+{
+    m_target = target;
+    m_diff   = toDiff(m_target);
+
+#   ifdef XMRIG_PROXY_PROJECT
+    Cvt::toHex(m_rawTarget, sizeof(m_rawTarget), reinterpret_cast<uint8_t *>(&m_target), sizeof(m_target));
+#   endif
+}
+
+
 void xmrig::Job::setDiff(uint64_t diff)
 {
     m_diff   = diff;
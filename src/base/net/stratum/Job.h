@@ -61,8 +61,11 @@ public:
     bool isEqual(const Job &other) const;
     bool isEqualBlob(const Job &other) const;
     bool setBlob(const char *blob);
+    bool setBlob(const uint8_t *blob, size_t size);
     bool setSeedHash(const char *hash);
+    bool setSeedHash(const uint8_t *hash, size_t size);
     bool setTarget(const char *target);
+    void setTarget(uint64_t target);
     void setDiff(uint64_t diff);
     void setSigKey(const char *sig_key);
 
@@ -37,6 +37,10 @@
 namespace xmrig {
 
 
+static const std::array<uint64_t, 4> kWakeupBuckets = { { 1000, 2000, 5000, 10000 } };
+static const char *kWakeupNames[]                   = { "<1", "<2", "<5", "<10", ">=10" };
+
+
 inline static void printCount(uint64_t accepted, uint64_t rejected)
 {
     float percent   = 100.0;
@@ -92,7 +96,7 @@ inline static void printDiff(size_t i, uint64_t diff, uint64_t hashes)
 }
 
 
-inline static void printLatency(uint32_t latency)
+inline static void printLatency(const char *name, uint64_t latency)
 {
     if (!latency) {
         return;
@@ -100,7 +104,32 @@ inline static void printLatency(uint32_t latency)
 
     const int color = latency < 100 ? 2 : (latency > 500 ? 1 : 3);
 
-    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CSI "1;3%dm%ums", "ping time", color, latency);
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CSI "1;3%dm%" PRIu64 "ms", name, color, latency);
+}
+
+
+static void printWakeup(const std::array<uint64_t, 5> &wakeup)
+{
+    char buf[128]{};
+    int length = 0;
+
+    for (size_t i = 0; i < wakeup.size(); ++i) {
+        length += snprintf(buf + length, sizeof(buf) - length, "%s%s:%" PRIu64, i ? " " : "", kWakeupNames[i], wakeup[i]);
+    }
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%s") " ms", "loop wakeup", buf);
+}
+
+
+inline static void printJobLatency(uint32_t median, uint64_t max)
+{
+    if (!max) {
+        return;
+    }
+
+    const int color = median < 1000 ? 2 : (median > 10000 ? 1 : 3);
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CSI "1;3%dm%1.2fms" CLEAR BLACK_BOLD(" (max %1.2fms)"), "job latency", color, median / 1000.0, max / 1000.0);
 }
 
 
@@ -125,6 +154,16 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("uptime",          connectionTime() / 1000, allocator);
     connection.AddMember("uptime_ms",       connectionTime(), allocator);
     connection.AddMember("ping",            latency(), allocator);
+    connection.AddMember("rtt",             m_rtt, allocator);
+    connection.AddMember("job_latency_us",  jobLatency(), allocator);
+    connection.AddMember("job_latency_max_us", m_maxJobLatency, allocator);
+
+    Value wakeup(kObjectType);
+    for (size_t i = 0; i < m_wakeup.size(); ++i) {
+        wakeup.AddMember(StringRef(kWakeupNames[i]), m_wakeup[i], allocator);
+    }
+
+    connection.AddMember("wakeup_ms",       wakeup, allocator);
     connection.AddMember("failures",        m_failures, allocator);
     connection.AddMember("tls",             m_tls.toJSON(), allocator);
     connection.AddMember("tls-fingerprint", m_fingerprint.toJSON(), allocator);
@@ -191,7 +230,10 @@ void xmrig::NetworkState::printConnection() const
 
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") WHITE_BOLD("%s"), "algorithm", m_algorithm.name());
     printDiff(m_diff);
-    printLatency(latency());
+    printLatency("ping time", latency());
+    printLatency("keepalive rtt", m_rtt);
+    printJobLatency(jobLatency(), m_maxJobLatency);
+    printWakeup(m_wakeup);
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%" PRIu64 "s"), "connection time", connectionTime() / 1000);
 }
 
@@ -223,6 +265,27 @@ void xmrig::NetworkState::printResults() const
 }
 
 
+void xmrig::NetworkState::addJobLatency(uint64_t usec)
+{
+    constexpr size_t kMaxJobs = 1024;
+
+    if (m_jobLatency.size() >= kMaxJobs) {
+        m_jobLatency.erase(m_jobLatency.begin(), m_jobLatency.begin() + kMaxJobs / 2);
+    }
+
+    m_jobLatency.push_back(static_cast<uint32_t>(std::min<uint64_t>(usec, 0xFFFFFFFF)));
+    m_maxJobLatency = std::max(m_maxJobLatency, usec);
+}
+
+
+void xmrig::NetworkState::addWakeupLatency(uint64_t usec)
+{
+    const auto it = std::upper_bound(kWakeupBuckets.begin(), kWakeupBuckets.end(), usec);
+
+    m_wakeup[static_cast<size_t>(std::distance(kWakeupBuckets.begin(), it))]++;
+}
+
+
 const char *xmrig::NetworkState::scaleDiff(uint64_t &diff)
 {
     if (diff >= 100000000000) {
@@ -296,6 +359,20 @@ void xmrig::NetworkState::onResultAccepted(IStrategy *strategy, IClient *client,
 }
 
 
+uint32_t xmrig::NetworkState::jobLatency() const
+{
+    const size_t jobs = m_jobLatency.size();
+    if (jobs == 0) {
+        return 0;
+    }
+
+    auto v = m_jobLatency;
+    std::nth_element(v.begin(), v.begin() + jobs / 2, v.end());
+
+    return v[jobs / 2];
+}
+
+
 uint32_t xmrig::NetworkState::latency() const
 {
     const size_t calls = m_latency.size();
@@ -355,5 +432,8 @@ void xmrig::NetworkState::stop()
     m_fingerprint = nullptr;
 
     m_failures++;
+    m_rtt = 0;
     m_latency.clear();
+    m_jobLatency.clear();
+    m_maxJobLatency = 0;
 }
@@ -39,14 +39,22 @@ public:
     NetworkState(IStrategyListener *listener);
 
     inline const Algorithm &algorithm() const   { return m_algorithm; }
+    inline const char *pool() const             { return m_pool; }
     inline uint64_t accepted() const            { return m_accepted; }
+    inline uint64_t failures() const            { return m_failures; }
+    inline uint64_t hashes() const              { return m_hashes; }
     inline uint64_t rejected() const            { return m_rejected; }
+    inline void setRtt(uint64_t rtt)            { m_rtt = m_active ? rtt : 0; }
 
 #   ifdef XMRIG_FEATURE_API
     rapidjson::Value getConnection(rapidjson::Document &doc, int version) const;
     rapidjson::Value getResults(rapidjson::Document &doc, int version) const;
 #   endif
 
+    uint32_t jobLatency() const;
+    uint32_t latency() const;
+    void addJobLatency(uint64_t usec);
+    void addWakeupLatency(uint64_t usec);
     void printConnection() const;
     void printResults() const;
 
@@ -60,7 +68,6 @@ protected:
     void onResultAccepted(IStrategy *strategy, IClient *client, const SubmitResult &result, const char *error) override;
 
 private:
-    uint32_t latency() const;
     uint64_t avgTime() const;
     uint64_t connectionTime() const;
     void add(const SubmitResult &result, const char *error);
@@ -70,7 +77,9 @@ private:
     bool m_active               = false;
     char m_pool[256]{};
     std::array<uint64_t, 10> m_topDiff { { } };
+    std::array<uint64_t, 5> m_wakeup { { } };
     std::vector<uint16_t> m_latency;
+    std::vector<uint32_t> m_jobLatency;
     String m_fingerprint;
     String m_ip;
     String m_tls;
@@ -79,7 +88,9 @@ private:
     uint64_t m_diff             = 0;
     uint64_t m_failures         = 0;
     uint64_t m_hashes           = 0;
+    uint64_t m_maxJobLatency    = 0;
     uint64_t m_rejected         = 0;
+    uint64_t m_rtt              = 0;
 };
 
 
@@ -17,6 +17,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
@@ -29,6 +30,7 @@
 #include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/Platform.h"
+#include "base/net/stratum/BinaryClient.h"
 #include "base/net/stratum/Client.h"
 
 #if defined XMRIG_ALGO_KAWPOW || defined XMRIG_ALGO_GHOSTRIDER
@@ -64,6 +66,7 @@ const String Pool::kDefaultUser           = "x";
 const char *Pool::kAlgo                   = "algo";
 const char *Pool::kCoin                   = "coin";
 const char *Pool::kDaemon                 = "daemon";
+const char *Pool::kDaemonBroadcast        = "daemon-broadcast";
 const char *Pool::kDaemonPollInterval     = "daemon-poll-interval";
 const char *Pool::kDaemonJobTimeout       = "daemon-job-timeout";
 const char *Pool::kDaemonZMQPort          = "daemon-zmq-port";
@@ -81,6 +84,9 @@ const char *Pool::kSni                    = "sni";
 const char *Pool::kUrl                    = "url";
 const char *Pool::kUser                   = "user";
 const char *Pool::kSpendSecretKey         = "spend-secret-key";
+const char *Pool::kPingInterval           = "ping-interval";
+const char *Pool::kStaleJobTimeout        = "stale-job-timeout";
+const char *Pool::kTcpUserTimeout         = "tcp-user-timeout";
 const char *Pool::kNicehashHost           = "nicehash.com";
 
 
@@ -134,6 +140,8 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_daemon         = Json::getString(object, kSelfSelect);
     m_proxy          = Json::getValue(object, kSOCKS5);
     m_zmqPort        = Json::getInt(object, kDaemonZMQPort, m_zmqPort);
+    m_pingInterval   = std::max(Json::getInt(object, kPingInterval, kDefaultPingInterval), 0);
+    m_tcpUserTimeout = std::max(Json::getInt(object, kTcpUserTimeout), 0);
 
     m_flags.set(FLAG_ENABLED,  Json::getBool(object, kEnabled, true));
     m_flags.set(FLAG_NICEHASH, Json::getBool(object, kNicehash) || m_url.host().contains(kNicehashHost));
@@ -141,6 +149,7 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_flags.set(FLAG_SNI,      Json::getBool(object, kSni));
 
     setKeepAlive(Json::getValue(object, kKeepalive));
+    setStaleJobTimeout(Json::getValue(object, kStaleJobTimeout));
 
     if (m_daemon.isValid()) {
         m_mode           = MODE_SELF_SELECT;
@@ -148,6 +157,20 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     }
     else if (Json::getBool(object, kDaemon)) {
         m_mode = MODE_DAEMON;
+
+        const auto &broadcast = Json::getArray(object, kDaemonBroadcast);
+        if (broadcast.IsArray()) {
+            for (const auto &value : broadcast.GetArray()) {
+                Url url(value.IsString() ? value.GetString() : nullptr);
+
+                if (url.isValid()) {
+                    m_broadcast.emplace_back(std::move(url));
+                }
+            }
+        }
+    }
+    else if (m_url.scheme() == Url::BINARY) {
+        m_mode = MODE_BINARY;
     }
 }
 
@@ -205,6 +228,9 @@ bool xmrig::Pool::isEqual(const Pool &other) const
 {
     return (m_flags           == other.m_flags
             && m_keepAlive    == other.m_keepAlive
+            && m_pingInterval == other.m_pingInterval
+            && m_staleJobTimeout == other.m_staleJobTimeout
+            && m_tcpUserTimeout  == other.m_tcpUserTimeout
             && m_algorithm    == other.m_algorithm
             && m_coin         == other.m_coin
             && m_mode         == other.m_mode
@@ -216,6 +242,8 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_pollInterval == other.m_pollInterval
             && m_jobTimeout   == other.m_jobTimeout
             && m_daemon       == other.m_daemon
+            && m_zmqPort      == other.m_zmqPort
+            && m_broadcast    == other.m_broadcast
             && m_proxy        == other.m_proxy
             );
 }
@@ -237,6 +265,9 @@ xmrig::IClient *xmrig::Pool::createClient(int id, IClientListener *listener) con
             client = new Client(id, Platform::userAgent(), listener);
         }
     }
+    else if (m_mode == MODE_BINARY) {
+        client = new BinaryClient(id, Platform::userAgent(), listener);
+    }
 #   ifdef XMRIG_FEATURE_HTTP
     else if (m_mode == MODE_DAEMON) {
         client = new DaemonClient(id, listener);
@@ -297,6 +328,17 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
         else {
             obj.AddMember(StringRef(kKeepalive), m_keepAlive, allocator);
         }
+
+        obj.AddMember(StringRef(kPingInterval), m_pingInterval, allocator);
+
+        if (m_staleJobTimeout < 0) {
+            obj.AddMember(StringRef(kStaleJobTimeout), true, allocator);
+        }
+        else {
+            obj.AddMember(StringRef(kStaleJobTimeout), m_staleJobTimeout, allocator);
+        }
+
+        obj.AddMember(StringRef(kTcpUserTimeout), m_tcpUserTimeout, allocator);
     }
 
     obj.AddMember(StringRef(kEnabled),      m_flags.test(FLAG_ENABLED), allocator);
@@ -310,10 +352,21 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
         obj.AddMember(StringRef(kDaemonPollInterval), m_pollInterval, allocator);
         obj.AddMember(StringRef(kDaemonJobTimeout), m_jobTimeout, allocator);
         obj.AddMember(StringRef(kDaemonZMQPort), m_zmqPort, allocator);
+
+        Value broadcast(kArrayType);
+        for (const auto &url : m_broadcast) {
+            broadcast.PushBack(url.url().toJSON(), allocator);
+        }
+
+        obj.AddMember(StringRef(kDaemonBroadcast), broadcast, allocator);
     }
     else {
         obj.AddMember(StringRef(kSelfSelect),     m_daemon.url().toJSON(), allocator);
         obj.AddMember(StringRef(kSubmitToOrigin), m_submitToOrigin, allocator);
+
+        if (m_mode == MODE_SELF_SELECT) {
+            obj.AddMember(StringRef(kDaemonZMQPort), m_zmqPort, allocator);
+        }
     }
 
     return obj;
@@ -339,6 +392,17 @@ std::string xmrig::Pool::printableName() const
 }
 
 
+uint64_t xmrig::Pool::staleJobTimeout() const
+{
+    if (m_staleJobTimeout >= 0) {
+        return static_cast<uint64_t>(m_staleJobTimeout) * 1000;
+    }
+
+    // Pools send at least one job per block, so a connection that stays silent for many expected block intervals is dead.
+    return m_coin.target() * kStaleJobBlocks * 1000;
+}
+
+
 #ifdef APP_DEBUG
 void xmrig::Pool::print() const
 {
@@ -367,3 +431,14 @@ void xmrig::Pool::setKeepAlive(const rapidjson::Value &value)
         setKeepAlive(value.GetBool());
     }
 }
+
+
+void xmrig::Pool::setStaleJobTimeout(const rapidjson::Value &value)
+{
+    if (value.IsInt()) {
+        m_staleJobTimeout = std::max(value.GetInt(), 0);
+    }
+    else if (value.IsBool()) {
+        m_staleJobTimeout = value.GetBool() ? -1 : 0;
+    }
+}
@@ -47,6 +47,7 @@ public:
         MODE_DAEMON,
         MODE_SELF_SELECT,
         MODE_AUTO_ETH,
+        MODE_BINARY,
 #       ifdef XMRIG_FEATURE_BENCHMARK
         MODE_BENCHMARK,
 #       endif
@@ -58,6 +59,7 @@ public:
     static const char *kAlgo;
     static const char *kCoin;
     static const char *kDaemon;
+    static const char *kDaemonBroadcast;
     static const char *kDaemonPollInterval;
     static const char *kDaemonJobTimeout;
     static const char *kEnabled;
@@ -75,12 +77,17 @@ public:
     static const char *kUser;
     static const char *kSpendSecretKey;
     static const char *kDaemonZMQPort;
+    static const char *kPingInterval;
+    static const char *kStaleJobTimeout;
+    static const char *kTcpUserTimeout;
     static const char *kNicehashHost;
 
     constexpr static int kKeepAliveTimeout         = 60;
+    constexpr static int kDefaultPingInterval      = 30;
     constexpr static uint16_t kDefaultPort         = 3333;
     constexpr static uint64_t kDefaultPollInterval = 1000;
     constexpr static uint64_t kDefaultJobTimeout   = 15000;
+    constexpr static uint64_t kStaleJobBlocks      = 10;
 
     Pool() = default;
     Pool(const char *host, uint16_t port, const char *user, const char *password, const char* spendSecretKey, int keepAlive, bool nicehash, bool tls, Mode mode);
@@ -108,8 +115,11 @@ public:
     inline const String &url() const                    { return m_url.url(); }
     inline const String &user() const                   { return !m_user.isNull() ? m_user : kDefaultUser; }
     inline const String &spendSecretKey() const         { return m_spendSecretKey; }
+    inline const std::vector<Url> &broadcast() const    { return m_broadcast; }
     inline const Url &daemon() const                    { return m_daemon; }
     inline int keepAlive() const                        { return m_keepAlive; }
+    inline int pingInterval() const                     { return m_pingInterval; }
+    inline int tcpUserTimeout() const                   { return m_tcpUserTimeout; }
     inline Mode mode() const                            { return m_mode; }
     inline uint16_t port() const                        { return m_url.port(); }
     inline int zmq_port() const                         { return m_zmqPort; }
@@ -130,6 +140,7 @@ public:
     IClient *createClient(int id, IClientListener *listener) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
     std::string printableName() const;
+    uint64_t staleJobTimeout() const;
 
 #   ifdef APP_DEBUG
     void print() const;
@@ -148,11 +159,15 @@ private:
     inline void setKeepAlive(int keepAlive)             { m_keepAlive = keepAlive >= 0 ? keepAlive : 0; }
 
     void setKeepAlive(const rapidjson::Value &value);
+    void setStaleJobTimeout(const rapidjson::Value &value);
 
     Algorithm m_algorithm;
     bool m_submitToOrigin           = false;
     Coin m_coin;
     int m_keepAlive                 = 0;
+    int m_pingInterval              = kDefaultPingInterval;
+    int m_staleJobTimeout           = -1;
+    int m_tcpUserTimeout            = 0;
     Mode m_mode                     = MODE_POOL;
     ProxyUrl m_proxy;
     std::bitset<FLAG_MAX> m_flags   = 0;
@@ -161,6 +176,7 @@ private:
     String m_rigId;
     String m_user;
     String m_spendSecretKey;
+    std::vector<Url> m_broadcast;
     uint64_t m_pollInterval         = kDefaultPollInterval;
     uint64_t m_jobTimeout           = kDefaultJobTimeout;
     Url m_daemon;
@@ -29,6 +29,7 @@
 #include "base/net/http/Fetch.h"
 #include "base/net/http/HttpData.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/stratum/ZmqSubscriber.h"
 #include "net/JobResult.h"
 #include "base/tools/Cvt.h"
 
@@ -57,17 +58,42 @@ xmrig::SelfSelectClient::SelfSelectClient(int id, const char *agent, IClientList
 {
     m_httpListener  = std::make_shared<HttpListener>(this);
     m_client        = new Client(id, agent, this);
+    m_zmq           = new ZmqSubscriber(this);
 }
 
 
 xmrig::SelfSelectClient::~SelfSelectClient()
 {
+    delete m_zmq;
     delete m_client;
 }
 
 
+bool xmrig::SelfSelectClient::requestJob()
+{
+    if (!m_active) {
+        return false;
+    }
+
+    // The extra nonce belongs to the pool, a new template from the daemon gives a new hashing blob for the same pool job.
+    if (m_state == IdleState) {
+        getBlockTemplate();
+    }
+
+    return true;
+}
+
+
 int64_t xmrig::SelfSelectClient::submit(const JobResult &result)
 {
+    if (result.diff == 0) {
+        if (!requestJob()) {
+            m_client->submit(result);
+        }
+
+        return -1;
+    }
+
     if (m_submitToOrigin) {
         submitOriginDaemon(result);
     }
@@ -83,10 +109,21 @@ int64_t xmrig::SelfSelectClient::submit(const JobResult &result)
 }
 
 
+void xmrig::SelfSelectClient::deleteLater()
+{
+    m_zmq->close();
+    m_client->deleteLater();
+}
+
+
 void xmrig::SelfSelectClient::tick(uint64_t now)
 {
     m_client->tick(now);
 
+    if (m_active && pool().zmq_port() > 0 && !m_zmq->isActive() && Chrono::steadyMSecs() - m_zmqTimestamp >= m_retryPause) {
+        m_zmq->connect(pool().daemon().host(), pool().zmq_port());
+    }
+
     if (m_state == RetryState) {
         if (Chrono::steadyMSecs() - m_timestamp < m_retryPause) {
             return;
@@ -97,10 +134,34 @@ void xmrig::SelfSelectClient::tick(uint64_t now)
 }
 
 
+void xmrig::SelfSelectClient::onClose(IClient *, int failures)
+{
+    m_listener->onClose(this, failures);
+    setState(IdleState);
+    m_active = false;
+
+    m_zmq->close();
+    resetTemplate();
+}
+
+
 void xmrig::SelfSelectClient::onJobReceived(IClient *, const Job &job, const rapidjson::Value &)
 {
     m_job = job;
 
+    // Template for the new chain tip is already prefetched, only the pool round trip is left.
+    if (isTemplateReusable()) {
+        rapidjson::Document doc;
+        doc.Swap(m_template);
+
+        m_prefetchId = 0;
+        setState(WaitState);
+
+        if (applyBlockTemplate(doc, false)) {
+            return;
+        }
+    }
+
     getBlockTemplate();
 }
 
@@ -113,6 +174,50 @@ void xmrig::SelfSelectClient::onLogin(IClient *, rapidjson::Document &doc, rapid
 }
 
 
+void xmrig::SelfSelectClient::onLoginSuccess(IClient *)
+{
+    m_listener->onLoginSuccess(this);
+    setState(IdleState);
+    m_active = true;
+
+    if (pool().zmq_port() > 0 && !m_zmq->isActive()) {
+        m_zmq->connect(pool().daemon().host(), pool().zmq_port());
+    }
+}
+
+
+bool xmrig::SelfSelectClient::applyBlockTemplate(rapidjson::Value &result, bool speculative)
+{
+    const char *blobData = Json::getString(result, kBlockhashingBlob);
+    if (pool().coin().isValid()) {
+        uint8_t blobVersion = 0;
+        if (blobData) {
+            Cvt::fromHex(&blobVersion, 1, blobData, 2);
+        }
+        m_job.setAlgorithm(pool().coin().algorithm(blobVersion));
+    }
+
+    if (!m_job.setBlob(blobData)) {
+        return false;
+    }
+
+    m_job.setHeight(Json::getUint64(result, kHeight));
+    m_job.setSeedHash(Json::getString(result, kSeedHash));
+
+    m_prevHash = Json::getString(result, kPrevHash);
+
+    submitBlockTemplate(result, speculative);
+
+    return true;
+}
+
+
+bool xmrig::SelfSelectClient::isTemplateReusable() const
+{
+    return m_template.IsObject() && m_templateWallet == m_job.poolWallet() && m_templateExtraNonce == m_job.extraNonce();
+}
+
+
 bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result, const rapidjson::Value &error)
 {
     if (id == -1) {
@@ -137,30 +242,35 @@ bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result
         }
     }
 
-    const char *blobData = Json::getString(result, kBlockhashingBlob);
-    if (pool().coin().isValid()) {
-        uint8_t blobVersion = 0;
-        if (blobData) {
-            Cvt::fromHex(&blobVersion, 1, blobData, 2);
-        }
-        m_job.setAlgorithm(pool().coin().algorithm(blobVersion));
-    }
+    // Only the latest request is handled (see onHttpData), so its id tells if it was a prefetch.
+    const bool prefetch = id == m_prefetchId;
 
-    if (!m_job.setBlob(blobData)) {
-        return false;
-    }
+    if (prefetch) {
+        // The daemon may notify about a new block before its RPC returns a template on top of it.
+        if (m_prevHash == Json::getString(result, kPrevHash)) {
+            setState(IdleState);
 
-    m_job.setHeight(Json::getUint64(result, kHeight));
-    m_job.setSeedHash(Json::getString(result, kSeedHash));
+            return true;
+        }
 
-    submitBlockTemplate(result);
+        // Strings of the response reference the receive buffer, they must be copied to outlive it.
+        rapidjson::Document copy;
+        copy.CopyFrom(result, copy.GetAllocator(), true);
+        m_template.Swap(copy);
 
-    return true;
+        m_templateWallet     = m_job.poolWallet();
+        m_templateExtraNonce = m_job.extraNonce();
+    }
+
+    return applyBlockTemplate(result, prefetch);
 }
 
 
-void xmrig::SelfSelectClient::getBlockTemplate()
+void xmrig::SelfSelectClient::getBlockTemplate(bool prefetch)
 {
+    const int64_t id = m_sequence++;
+    m_prefetchId     = prefetch ? id : 0;
+
     setState(WaitState);
 
     using namespace rapidjson;
@@ -171,7 +281,7 @@ void xmrig::SelfSelectClient::getBlockTemplate()
     params.AddMember("wallet_address",  m_job.poolWallet().toJSON(), allocator);
     params.AddMember("extra_nonce",     m_job.extraNonce().toJSON(), allocator);
 
-    JsonRequest::create(doc, m_sequence++, "getblocktemplate", params);
+    JsonRequest::create(doc, id, "getblocktemplate", params);
 
     FetchRequest req(HTTP_POST, pool().daemon().host(), pool().daemon().port(), "/json_rpc", doc, pool().daemon().isTLS(), isQuiet());
     fetch(tag(), std::move(req), m_httpListener);
@@ -215,7 +325,7 @@ void xmrig::SelfSelectClient::setState(State state)
 }
 
 
-void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result)
+void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result, bool speculative)
 {
     using namespace rapidjson;
     Document doc(kObjectType);
@@ -236,8 +346,13 @@ void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result)
 
     JsonRequest::create(doc, sequence(), "block_template", params);
 
-    send(doc, [this](const rapidjson::Value &result, bool success, uint64_t) {
+    send(doc, [this, speculative](const rapidjson::Value &result, bool success, uint64_t) {
         if (!success) {
+            // Template was sent under the previous job id, the pool may not accept it until its own new job arrives.
+            if (speculative) {
+                return setState(IdleState);
+            }
+
             if (!isQuiet()) {
                 LOG_ERR("[%s] error: " RED_BOLD("\"%s\"") RED_S ", code: %d", pool().daemon().url().data(), Json::getString(result, "message"), Json::getInt(result, "code"));
             }
@@ -254,6 +369,14 @@ void xmrig::SelfSelectClient::submitBlockTemplate(rapidjson::Value &result)
         }
 
         setState(IdleState);
+
+        if (m_zmqNotifyMs) {
+            LOG_INFO("%s " WHITE_BOLD("new block template ready in ") CYAN_BOLD("%" PRIu64 " ms") BLACK_BOLD(" (%s)"),
+                     Tags::network(), Chrono::steadyMSecs() - m_zmqNotifyMs, speculative ? "prefetched" : "pool job");
+
+            m_zmqNotifyMs = 0;
+        }
+
         m_listener->onJobReceived(this, m_job, rapidjson::Value{});
     });
 }
@@ -294,14 +417,44 @@ void xmrig::SelfSelectClient::submitOriginDaemon(const JobResult& result)
         Tags::origin(), m_originSubmitted, m_originNotSubmitted, m_blockDiff, result.actualDiff(), result.diff);
 }
 
+void xmrig::SelfSelectClient::onZmqClose(ZmqSubscriber *)
+{
+    m_zmqTimestamp = Chrono::steadyMSecs();
+    resetTemplate();
+}
+
+
+void xmrig::SelfSelectClient::onZmqConnected(ZmqSubscriber *)
+{
+    LOG_INFO("%s " WHITE_BOLD("self-select ") CYAN("tcp-zmq://%s:%d") WHITE_BOLD(" subscribed to new blocks"), Tags::network(), pool().daemon().host().data(), pool().zmq_port());
+}
+
+
+void xmrig::SelfSelectClient::onZmqMessage(ZmqSubscriber *)
+{
+    m_zmqNotifyMs = Chrono::steadyMSecs();
+    resetTemplate();
+
+    // Fetch the next template right away, mining continues on the previous one until the pool accepts it.
+    if (m_active && !m_job.id().isNull()) {
+        getBlockTemplate(true);
+    }
+}
+
+
 void xmrig::SelfSelectClient::onHttpData(const HttpData &data)
 {
+    const BaseClient::ReadStamp stamp;
+
     if (data.status != 200) {
         return retry();
     }
 
+    // Parsed in situ: strings are not copied into the document, block templates can be hundreds of KB of hex.
+    std::string body = data.body;
     rapidjson::Document doc;
-    if (doc.Parse(data.body.c_str()).HasParseError()) {
+
+    if (doc.ParseInsitu(&body[0]).HasParseError()) {
         if (!isQuiet()) {
             LOG_ERR("[%s] JSON decode failed: \"%s\"",  pool().daemon().url().data(), rapidjson::GetParseError_En(doc.GetParseError()));
         }
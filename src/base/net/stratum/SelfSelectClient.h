@@ -23,7 +23,9 @@
 
 
 #include "base/kernel/interfaces/IClient.h"
+#include "3rdparty/rapidjson/document.h"
 #include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/IZmqListener.h"
 #include "base/net/http/HttpListener.h"
 #include "base/net/stratum/Job.h"
 
@@ -35,7 +37,10 @@
 namespace xmrig {
 
 
-class SelfSelectClient : public IClient, public IClientListener, public IHttpListener
+class ZmqSubscriber;
+
+
+class SelfSelectClient : public IClient, public IClientListener, public IHttpListener, public IZmqListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(SelfSelectClient)
@@ -60,9 +65,9 @@ protected:
     inline int64_t send(const rapidjson::Value &obj, Callback callback) override    { return m_client->send(obj, callback); }
     inline int64_t send(const rapidjson::Value &obj) override                       { return m_client->send(obj); }
     inline int64_t sequence() const override                                        { return m_client->sequence(); }
+    inline uint64_t rtt() const override                                            { return m_client->rtt(); }
     inline void connect() override                                                  { m_client->connect(); }
     inline void connect(const Pool &pool) override                                  { m_client->connect(pool); }
-    inline void deleteLater() override                                              { m_client->deleteLater(); }
     inline void setAlgo(const Algorithm &algo) override                             { m_client->setAlgo(algo); }
     inline void setEnabled(bool enabled) override                                   { m_client->setEnabled(enabled); }
     inline void setPool(const Pool &pool) override                                  { m_client->setPool(pool); }
@@ -71,21 +76,28 @@ protected:
     inline void setRetries(int retries) override                                    { m_client->setRetries(retries); m_retries = retries; }
     inline void setRetryPause(uint64_t ms) override                                 { m_client->setRetryPause(ms); m_retryPause = ms; }
 
+    bool requestJob() override;
     int64_t submit(const JobResult &result) override;
+    void deleteLater() override;
     void tick(uint64_t now) override;
 
     // IClientListener
-    inline void onClose(IClient *, int failures) override                                           { m_listener->onClose(this, failures); setState(IdleState); m_active = false; }
-    inline void onLoginSuccess(IClient *) override                                                  { m_listener->onLoginSuccess(this); setState(IdleState); m_active = true; }
     inline void onResultAccepted(IClient *, const SubmitResult &result, const char *error) override { m_listener->onResultAccepted(this, result, error); }
     inline void onVerifyAlgorithm(const IClient *, const Algorithm &algorithm, bool *ok) override   { m_listener->onVerifyAlgorithm(this, algorithm, ok); }
 
+    void onClose(IClient *, int failures) override;
     void onJobReceived(IClient *, const Job &job, const rapidjson::Value &params) override;
     void onLogin(IClient *, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *) override;
 
     // IHttpListener
     void onHttpData(const HttpData &data) override;
 
+    // IZmqListener
+    void onZmqClose(ZmqSubscriber *subscriber) override;
+    void onZmqConnected(ZmqSubscriber *subscriber) override;
+    void onZmqMessage(ZmqSubscriber *subscriber) override;
+
 private:
     enum State {
         IdleState,
@@ -93,13 +105,18 @@ private:
         RetryState
     };
 
-    inline bool isQuiet() const { return m_quiet || m_failures >= m_retries; }
+    inline bool isQuiet() const     { return m_quiet || m_failures >= m_retries; }
+
+    // SetNull() would keep the allocator pool with all previous templates, a new document releases it.
+    inline void resetTemplate()     { rapidjson::Document().Swap(m_template); }
 
+    bool applyBlockTemplate(rapidjson::Value &result, bool speculative);
+    bool isTemplateReusable() const;
     bool parseResponse(int64_t id, rapidjson::Value &result, const rapidjson::Value &error);
-    void getBlockTemplate();
+    void getBlockTemplate(bool prefetch = false);
     void retry();
     void setState(State state);
-    void submitBlockTemplate(rapidjson::Value &result);
+    void submitBlockTemplate(rapidjson::Value &result, bool speculative);
     void submitOriginDaemon(const JobResult &result);
 
     bool m_active                   = false;
@@ -109,17 +126,25 @@ private:
     IClientListener *m_listener;
     int m_retries                   = 5;
     int64_t m_failures              = 0;
+    int64_t m_prefetchId            = 0;
     int64_t m_sequence              = 1;
     Job m_job;
     State m_state                   = IdleState;
     std::map<int64_t, SubmitResult> m_results;
+    rapidjson::Document m_template;
     std::shared_ptr<IHttpListener> m_httpListener;
     String m_blocktemplate;
+    String m_prevHash;
+    String m_templateExtraNonce;
+    String m_templateWallet;
     uint64_t m_blockDiff            = 0;
     uint64_t m_originNotSubmitted   = 0;
     uint64_t m_originSubmitted      = 0;
     uint64_t m_retryPause           = 5000;
     uint64_t m_timestamp            = 0;
+    uint64_t m_zmqTimestamp         = 0;
+    uint64_t m_zmqNotifyMs          = 0;
+    ZmqSubscriber *m_zmq            = nullptr;
 };
 
 
@@ -35,6 +35,8 @@ namespace xmrig {
 static const char kStratumTcp[]            = "stratum+tcp://";
 static const char kStratumSsl[]            = "stratum+ssl://";
 static const char kSOCKS5[]                = "socks5://";
+static const char kBinaryTcp[]             = "binary+tcp://";
+static const char kBinarySsl[]             = "binary+ssl://";
 
 #ifdef XMRIG_FEATURE_HTTP
 static const char kDaemonHttp[]            = "daemon+http://";
@@ -94,6 +96,14 @@ bool xmrig::Url::parse(const char *url)
             m_scheme = SOCKS5;
             m_tls    = false;
         }
+        else if (strncasecmp(url, kBinaryTcp, sizeof(kBinaryTcp) - 1) == 0) {
+            m_scheme = BINARY;
+            m_tls    = false;
+        }
+        else if (strncasecmp(url, kBinarySsl, sizeof(kBinarySsl) - 1) == 0) {
+            m_scheme = BINARY;
+            m_tls    = true;
+        }
 #       ifdef XMRIG_FEATURE_HTTP
         else if (strncasecmp(url, kDaemonHttps, sizeof(kDaemonHttps) - 1) == 0) {
             m_scheme = DAEMON;
@@ -0,0 +1,370 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <uv.h>
+
+
+#include "base/net/stratum/ZmqSubscriber.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/IZmqListener.h"
+#include "base/kernel/Platform.h"
+#include "base/net/dns/Dns.h"
+#include "base/net/dns/DnsRecords.h"
+#include "base/net/tools/NetBuffer.h"
+#include "base/tools/bswap_64.h"
+
+
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static const char kGreeting[64] = { static_cast<char>(-1), 0, 0, 0, 0, 0, 0, 0, 0, 127, 3, 0, 'N', 'U', 'L', 'L' };
+static constexpr size_t kGreetingSize1  = 11;
+static constexpr size_t kMaxMessageSize = 1024;
+
+static const char kHandshake[] = "\4\x19\5READY\xbSocket-Type\0\0\0\3SUB";
+static const char kSubscribe[] = "\0\x18\1json-minimal-chain_main";
+
+
+} // namespace xmrig
+
+
+xmrig::ZmqSubscriber::ZmqSubscriber(IZmqListener *listener) :
+    m_listener(listener)
+{
+}
+
+
+xmrig::ZmqSubscriber::~ZmqSubscriber()
+{
+    m_listener = nullptr;
+
+    close();
+}
+
+
+void xmrig::ZmqSubscriber::close()
+{
+    m_dns.reset();
+    m_recvBuf.clear();
+    m_state = NotConnectedState;
+
+    if (!m_socket) {
+        return;
+    }
+
+    // The handle outlives this object until libuv is done with it, callbacks check the data pointer.
+    m_socket->data = nullptr;
+
+    if (Platform::hasKeepalive()) {
+        uv_tcp_keepalive(m_socket, 0, 60);
+    }
+
+    uv_close(reinterpret_cast<uv_handle_t *>(m_socket), onClose);
+    m_socket = nullptr;
+}
+
+
+void xmrig::ZmqSubscriber::connect(const String &host, int port)
+{
+    close();
+
+    m_host  = host;
+    m_port  = port;
+    m_state = ResolvingState;
+    m_dns   = Dns::resolve(m_host, this);
+}
+
+
+void xmrig::ZmqSubscriber::onResolved(const DnsRecords &records, int status, const char *error)
+{
+    m_dns.reset();
+
+    if (status < 0 && records.isEmpty()) {
+        LOG_ERR(CYAN("tcp-zmq://%s:%d") RED(" DNS error: ") RED_BOLD("\"%s\""), m_host.data(), m_port, error);
+
+        return this->error(nullptr);
+    }
+
+    const auto &record = records.get();
+    m_ip = record.ip();
+
+    auto req  = new uv_connect_t;
+    m_socket  = new uv_tcp_t;
+
+    m_socket->data = this;
+
+    uv_tcp_init(uv_default_loop(), m_socket);
+    uv_tcp_nodelay(m_socket, 1);
+
+    if (Platform::hasKeepalive()) {
+        uv_tcp_keepalive(m_socket, 1, 60);
+    }
+
+    m_state = ConnectingState;
+
+    uv_tcp_connect(req, m_socket, record.addr(static_cast<uint16_t>(m_port)), onConnect);
+}
+
+
+void xmrig::ZmqSubscriber::onClose(uv_handle_t *handle)
+{
+    delete reinterpret_cast<uv_tcp_t *>(handle);
+}
+
+
+void xmrig::ZmqSubscriber::onConnect(uv_connect_t *req, int status)
+{
+    auto subscriber = static_cast<ZmqSubscriber *>(req->handle->data);
+    delete req;
+
+    if (!subscriber) {
+        return;
+    }
+
+    if (status < 0) {
+        LOG_ERR(CYAN("tcp-zmq://%s:%d") RED(" connect error: ") RED_BOLD("\"%s\""), subscriber->m_host.data(), subscriber->m_port, uv_strerror(status));
+
+        return subscriber->error(nullptr);
+    }
+
+#   ifdef APP_DEBUG
+    LOG_DEBUG(CYAN("tcp-zmq://%s:%d") BLACK_BOLD(" connected"), subscriber->m_host.data(), subscriber->m_port);
+#   endif
+
+    subscriber->m_state = Greeting1State;
+    subscriber->m_sendBuf.reserve(256);
+    subscriber->m_recvBuf.reserve(256);
+
+    if (subscriber->write(kGreeting, kGreetingSize1)) {
+        uv_read_start(reinterpret_cast<uv_stream_t *>(subscriber->m_socket), NetBuffer::onAlloc, onRead);
+    }
+}
+
+
+void xmrig::ZmqSubscriber::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    auto subscriber = static_cast<ZmqSubscriber *>(stream->data);
+    if (subscriber) {
+        subscriber->read(nread, buf);
+    }
+
+    NetBuffer::release(buf);
+}
+
+
+bool xmrig::ZmqSubscriber::parse()
+{
+    size_t msg_size = 0;
+
+    char *data   = m_recvBuf.data();
+    size_t avail = m_recvBuf.size();
+    bool more    = false;
+
+    do {
+        if (avail < 1) {
+            return false;
+        }
+
+        more                 = (data[0] & 1) != 0;
+        const bool long_size = (data[0] & 2) != 0;
+        const bool command   = (data[0] & 4) != 0;
+
+        ++data;
+        --avail;
+
+        uint64_t size = 0;
+        if (long_size) {
+            if (avail < sizeof(uint64_t)) {
+                return false;
+            }
+
+            uint64_t value = 0;
+            memcpy(&value, data, sizeof(value));
+            size = bswap_64(value);
+            data += sizeof(uint64_t);
+            avail -= sizeof(uint64_t);
+        }
+        else {
+            if (avail < sizeof(uint8_t)) {
+                return false;
+            }
+
+            size = static_cast<uint8_t>(*data);
+            ++data;
+            --avail;
+        }
+
+        if (size > kMaxMessageSize - msg_size) {
+            LOG_ERR(CYAN("tcp-zmq://%s:%d") RED(" message is too large, size = %" PRIu64 " bytes"), m_host.data(), m_port, size);
+            error(nullptr);
+
+            return false;
+        }
+
+        if (avail < size) {
+            return false;
+        }
+
+        if (!command) {
+            msg_size += size;
+        }
+
+        data += size;
+        avail -= size;
+    } while (more);
+
+    m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + (data - m_recvBuf.data()));
+
+#   ifdef APP_DEBUG
+    LOG_DEBUG(CYAN("tcp-zmq://%s:%d") BLACK_BOLD(" read ") CYAN_BOLD("%zu") BLACK_BOLD(" bytes"), m_host.data(), m_port, msg_size);
+#   endif
+
+    m_listener->onZmqMessage(this);
+
+    return true;
+}
+
+
+bool xmrig::ZmqSubscriber::write(const char *data, size_t size)
+{
+    m_sendBuf.assign(data, data + size);
+
+    uv_buf_t buf;
+    buf.base = m_sendBuf.data();
+    buf.len  = static_cast<uint32_t>(m_sendBuf.size());
+
+    const int rc = uv_try_write(reinterpret_cast<uv_stream_t *>(m_socket), &buf, 1);
+    if (static_cast<size_t>(rc) == buf.len) {
+        return true;
+    }
+
+    LOG_ERR(CYAN("tcp-zmq://%s:%d") RED(" write failed, rc = %d"), m_host.data(), m_port, rc);
+    error(nullptr);
+
+    return false;
+}
+
+
+void xmrig::ZmqSubscriber::error(const char *message)
+{
+    if (message) {
+        LOG_ERR(CYAN("tcp-zmq://%s:%d") RED(" %s"), m_host.data(), m_port, message);
+    }
+
+    close();
+
+    if (m_listener) {
+        m_listener->onZmqClose(this);
+    }
+}
+
+
+void xmrig::ZmqSubscriber::read(ssize_t nread, const uv_buf_t *buf)
+{
+    if (nread <= 0) {
+        LOG_ERR(CYAN("tcp-zmq://%s:%d") RED(" read failed, nread = %" PRId64), m_host.data(), m_port, static_cast<int64_t>(nread));
+
+        return error(nullptr);
+    }
+
+    m_recvBuf.insert(m_recvBuf.end(), buf->base, buf->base + nread);
+
+    do {
+        switch (m_state) {
+        case Greeting1State:
+            if (m_recvBuf.size() < kGreetingSize1) {
+                return;
+            }
+
+            if ((m_recvBuf[0] != static_cast<char>(-1)) || (m_recvBuf[9] != 127) || (m_recvBuf[10] != 3)) {
+                return error("handshake failed: invalid greeting format");
+            }
+
+            if (!write(kGreeting + kGreetingSize1, sizeof(kGreeting) - kGreetingSize1)) {
+                return;
+            }
+
+            m_state = Greeting2State;
+            break;
+
+        case Greeting2State:
+            if (m_recvBuf.size() < sizeof(kGreeting)) {
+                return;
+            }
+
+            if (memcmp(m_recvBuf.data() + 12, kGreeting + 12, 20) != 0) {
+                return error("handshake failed: invalid greeting format 2");
+            }
+
+            m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + sizeof(kGreeting));
+
+            if (!write(kHandshake, sizeof(kHandshake) - 1)) {
+                return;
+            }
+
+            m_state = HandshakeState;
+            break;
+
+        case HandshakeState:
+            {
+                if (m_recvBuf.size() < 2) {
+                    return;
+                }
+
+                if (m_recvBuf[0] != 4) {
+                    return error("handshake failed: invalid handshake format");
+                }
+
+                const size_t size = static_cast<unsigned char>(m_recvBuf[1]);
+                if (size < 18) {
+                    return error("handshake failed: invalid handshake size");
+                }
+
+                if (m_recvBuf.size() < size + 2) {
+                    return;
+                }
+
+                if (memcmp(m_recvBuf.data() + 2, kHandshake + 2, 18) != 0) {
+                    return error("handshake failed: invalid handshake data");
+                }
+
+                if (!write(kSubscribe, sizeof(kSubscribe) - 1)) {
+                    return;
+                }
+
+                m_state = ConnectedState;
+                m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + size + 2);
+
+                m_listener->onZmqConnected(this);
+            }
+            break;
+
+        case ConnectedState:
+            if (!parse()) {
+                return;
+            }
+            break;
+
+        default:
+            return;
+        }
+    } while (m_socket);
+}
@@ -0,0 +1,103 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ZMQSUBSCRIBER_H
+#define XMRIG_ZMQSUBSCRIBER_H
+
+
+#include "base/kernel/interfaces/IDnsListener.h"
+#include "base/tools/String.h"
+
+
+#include <memory>
+#include <vector>
+
+
+using uv_buf_t      = struct uv_buf_t;
+using uv_connect_t  = struct uv_connect_s;
+using uv_handle_t   = struct uv_handle_s;
+using uv_stream_t   = struct uv_stream_s;
+using uv_tcp_t      = struct uv_tcp_s;
+
+
+namespace xmrig {
+
+
+class DnsRequest;
+class IZmqListener;
+
+
+/**
+ * Minimal ZMTP 3.0 SUB socket (NULL security) which subscribes to "json-minimal-chain_main"
+ * notifications of monerod. Message content is not used, every notification means the daemon
+ * switched to a new chain tip. Errors are reported through IZmqListener::onZmqClose, the listener decides when to reconnect.
+ */
+class ZmqSubscriber : public IDnsListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ZmqSubscriber)
+
+    ZmqSubscriber(IZmqListener *listener);
+    ~ZmqSubscriber() override;
+
+    inline bool isActive() const        { return m_state != NotConnectedState; }
+    inline bool isConnected() const     { return m_state == ConnectedState; }
+    inline const String &ip() const     { return m_ip; }
+
+    void close();
+    void connect(const String &host, int port);
+
+protected:
+    void onResolved(const DnsRecords &records, int status, const char *error) override;
+
+private:
+    enum State {
+        NotConnectedState,
+        ResolvingState,
+        ConnectingState,
+        Greeting1State,
+        Greeting2State,
+        HandshakeState,
+        ConnectedState
+    };
+
+    static void onClose(uv_handle_t *handle);
+    static void onConnect(uv_connect_t *req, int status);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    bool parse();
+    bool write(const char *data, size_t size);
+    void error(const char *message);
+    void read(ssize_t nread, const uv_buf_t *buf);
+
+    IZmqListener *m_listener;
+    int m_port                  = 0;
+    State m_state               = NotConnectedState;
+    std::shared_ptr<DnsRequest> m_dns;
+    std::vector<char> m_recvBuf;
+    std::vector<char> m_sendBuf;
+    String m_host;
+    String m_ip;
+    uv_tcp_t *m_socket          = nullptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_ZMQSUBSCRIBER_H */
@@ -18,12 +18,18 @@
 
 #include "core/Controller.h"
 #include "backend/cpu/Cpu.h"
+#include "base/kernel/Platform.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "net/Network.h"
 
 
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/common/LinuxMemory.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
 #   include "hw/api/HwApi.h"
@@ -51,6 +57,10 @@ int xmrig::Controller::init()
 
     VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().hugePageSize());
 
+#   ifdef XMRIG_OS_LINUX
+    LinuxMemory::setDropCaches(config()->cpu().isHugePagesDropCaches());
+#   endif
+
     m_network = std::make_shared<Network>(this);
 
 #   ifdef XMRIG_FEATURE_API
@@ -69,6 +79,10 @@ void xmrig::Controller::start()
     m_miner = std::make_shared<Miner>(this);
 
     network()->connect();
+
+    // This thread runs the event loop: pool I/O, job dispatch and share submission. Applied last, threads created
+    // so far (RandomX queue, libuv threadpool started by the first DNS lookup) keep the default timer slack.
+    Platform::setThreadSchedProfile(Platform::SCHED_PROFILE_LATENCY);
 }
 
 
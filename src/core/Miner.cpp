@@ -31,14 +31,22 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/net/stratum/Job.h"
+#include "base/net/stratum/NetworkState.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Object.h"
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "crypto/common/Nonce.h"
+#include "net/Network.h"
 #include "version.h"
 
 
+#ifdef XMRIG_OS_UNIX
+#   include "core/stats/StatsSegment.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
 #   include "base/api/interfaces/IApiRequest.h"
@@ -86,6 +94,10 @@ public:
     {
         delete timer;
 
+#       ifdef XMRIG_OS_UNIX
+        delete stats;
+#       endif
+
         for (IBackend *backend : backends) {
             delete backend;
         }
@@ -343,6 +355,102 @@ public:
     }
 
 
+#   ifdef XMRIG_OS_UNIX
+    void setStats(const String &path)
+    {
+        if (stats && stats->path() == path) {
+            return;
+        }
+
+        delete stats;
+        stats = path.isEmpty() ? nullptr : new StatsSegment(path);
+    }
+
+
+    void updateStats()
+    {
+        StatsData *data = stats ? stats->begin() : nullptr;
+        if (!data) {
+            return;
+        }
+
+        data->timestamp = Chrono::currentMSecsSinceEpoch();
+        data->uptime    = (Chrono::steadyMSecs() - startTime) / 1000;
+        data->paused    = !enabled;
+        data->threads   = 0;
+
+        double total[3] = { 0.0 };
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            total[0] += hr->calc(Hashrate::ShortInterval);
+            total[1] += hr->calc(Hashrate::MediumInterval);
+            total[2] += hr->calc(Hashrate::LargeInterval);
+
+            for (size_t i = 0; i < hr->threads() && data->threads < StatsData::kMaxThreads; ++i, ++data->threads) {
+                data->thread[data->threads][0] = hr->calc(i, Hashrate::ShortInterval);
+                data->thread[data->threads][1] = hr->calc(i, Hashrate::MediumInterval);
+                data->thread[data->threads][2] = hr->calc(i, Hashrate::LargeInterval);
+            }
+        }
+
+        for (size_t i = 0; i < 3; ++i) {
+            data->hashrate[i] = std::isnormal(total[i]) ? total[i] : nan("");
+        }
+
+        data->highest = maxHashrate[algorithm];
+
+        const auto pages    = cpu->hugePages();
+        data->hugePages[0]  = pages.allocated;
+        data->hugePages[1]  = pages.total;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            const char *jobId     = job.id().isNull() ? "" : job.id().data();
+            const bool jobChanged = strncmp(data->jobId, jobId, sizeof(data->jobId) - 1) != 0;
+
+            snprintf(data->algo, sizeof(data->algo), "%s", job.algorithm().isValid() ? job.algorithm().name() : "");
+            snprintf(data->jobId, sizeof(data->jobId), "%s", jobId);
+            memset(data->seed, 0, sizeof(data->seed));
+
+            if (!job.seed().empty()) {
+                memcpy(data->seed, job.seed().data(), std::min(job.seed().size(), sizeof(data->seed)));
+            }
+            data->height    = job.height();
+            data->diff      = job.diff();
+            data->dataset   = StatsData::DATASET_NONE;
+
+#           ifdef XMRIG_ALGO_RANDOMX
+            if (job.algorithm().family() == Algorithm::RANDOM_X) {
+                data->dataset = Rx::isReady(job) ? StatsData::DATASET_READY : StatsData::DATASET_INIT;
+            }
+#           endif
+
+            const NetworkState *state = controller->network()->state();
+            snprintf(data->pool, sizeof(data->pool), "%s", state->pool());
+
+            // Latency is a median over all shares, it only changes with a new result or job.
+            if (jobChanged || state->accepted() != data->accepted || state->rejected() != data->rejected) {
+                data->latency       = state->latency();
+                data->jobLatencyUs  = state->jobLatency();
+            }
+
+            data->accepted  = state->accepted();
+            data->rejected  = state->rejected();
+            data->failures  = state->failures();
+            data->hashes    = state->hashes();
+        }
+
+        stats->commit();
+    }
+#   endif
+
+
 #   ifdef XMRIG_ALGO_RANDOMX
     inline bool initRX() const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
 #   endif
@@ -362,13 +470,19 @@ public:
     int32_t auto_pause = 0;
     bool reset          = true;
     Controller *controller;
+    CpuBackend *cpu     = nullptr;
     Job job;
     mutable std::map<Algorithm::Id, double> maxHashrate;
     std::vector<IBackend *> backends;
     String userJobId;
     Timer *timer        = nullptr;
+    uint64_t startTime  = Chrono::steadyMSecs();
     uint64_t ticks      = 0;
 
+#   ifdef XMRIG_OS_UNIX
+    StatsSegment *stats = nullptr;
+#   endif
+
     Taskbar m_taskbar;
 };
 
@@ -402,8 +516,10 @@ xmrig::Miner::Miner(Controller *controller)
 
     d_ptr->timer = new Timer(this);
 
+    d_ptr->cpu = new CpuBackend(controller);
+
     d_ptr->backends.reserve(3);
-    d_ptr->backends.push_back(new CpuBackend(controller));
+    d_ptr->backends.push_back(d_ptr->cpu);
 
 #   ifdef XMRIG_FEATURE_OPENCL
     d_ptr->backends.push_back(new OclBackend(controller));
@@ -414,6 +530,10 @@ xmrig::Miner::Miner(Controller *controller)
 #   endif
 
     d_ptr->rebuild();
+
+#   ifdef XMRIG_OS_UNIX
+    d_ptr->setStats(controller->config()->statsShm());
+#   endif
 }
 
 
@@ -611,6 +731,10 @@ void xmrig::Miner::onConfigChanged(Config *config, Config *previousConfig)
 {
     d_ptr->rebuild();
 
+#   ifdef XMRIG_OS_UNIX
+    d_ptr->setStats(config->statsShm());
+#   endif
+
     if (config->pools() != previousConfig->pools() && config->pools().active() > 0) {
         return;
     }
@@ -654,6 +778,10 @@ void xmrig::Miner::onTimer(const Timer *)
 
     d_ptr->ticks++;
 
+#   ifdef XMRIG_OS_UNIX
+    d_ptr->updateStats();
+#   endif
+
     auto autoPause = [this](bool &state, bool pause, const char *pauseMessage, const char *activeMessage)
     {
         if ((pause && !state) || (!pause && state)) {
@@ -72,6 +72,10 @@ const char *Config::kHealthPrintTime    = "health-print-time";
 const char *Config::kDMI                = "dmi";
 #endif
 
+#ifdef XMRIG_OS_UNIX
+const char *Config::kStatsShm           = "stats-shm";
+#endif
+
 
 class ConfigPrivate
 {
@@ -100,6 +104,10 @@ public:
     bool dmi = true;
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    String statsShm;
+#   endif
+
     void setIdleTime(const rapidjson::Value &value)
     {
         if (value.IsBool()) {
@@ -184,6 +192,14 @@ bool xmrig::Config::isDMI() const
 #endif
 
 
+#ifdef XMRIG_OS_UNIX
+const xmrig::String &xmrig::Config::statsShm() const
+{
+    return d_ptr->statsShm;
+}
+#endif
+
+
 bool xmrig::Config::isShouldSave() const
 {
     if (!isAutoSave()) {
@@ -243,6 +259,10 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     d_ptr->dmi = reader.getBool(kDMI, d_ptr->dmi);
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    d_ptr->statsShm = reader.getString(kStatsShm);
+#   endif
+
     return true;
 }
 
@@ -293,6 +313,10 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(kDMI),                      isDMI(), allocator);
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    doc.AddMember(StringRef(kStatsShm),                 statsShm().toJSON(), allocator);
+#   endif
+
     doc.AddMember(StringRef(kSyslog),                   isSyslog(), allocator);
 
 #   ifdef XMRIG_FEATURE_TLS
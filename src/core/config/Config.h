@@ -63,6 +63,10 @@ public:
     static const char *kDMI;
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    static const char *kStatsShm;
+#   endif
+
     Config();
     ~Config() override;
 
@@ -96,6 +100,10 @@ public:
     static constexpr inline bool isDMI()    { return false; }
 #   endif
 
+#   ifdef XMRIG_OS_UNIX
+    const String &statsShm() const;
+#   endif
+
     bool isShouldSave() const;
     bool read(const IJsonReader &reader, const char *fileName) override;
     void getJSON(rapidjson::Document &doc) const override;
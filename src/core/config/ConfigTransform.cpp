@@ -153,6 +153,11 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::PauseOnActiveKey: /* --pause-on-active */
         return set(doc, Config::kPauseOnActive, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
 
+#   ifdef XMRIG_OS_UNIX
+    case IConfig::StatsShmKey: /* --stats-shm */
+        return set(doc, Config::kStatsShm, arg);
+#   endif
+
 #   ifdef XMRIG_ALGO_ARGON2
     case IConfig::Argon2ImplKey: /* --argon2-impl */
         return set(doc, CpuConfig::kField, CpuConfig::kArgon2Impl, arg);
@@ -191,6 +196,9 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::RandomXCacheQoSKey: /* --cache-qos */
         return set(doc, RxConfig::kField, RxConfig::kCacheQoS, true);
 
+    case IConfig::RandomXAutotuneKey: /* --randomx-autotune */
+        return set(doc, RxConfig::kField, RxConfig::kAutotune, true);
+
     case IConfig::HugePagesJitKey: /* --huge-pages-jit */
         return set(doc, CpuConfig::kField, CpuConfig::kHugePagesJit, true);
 #   endif
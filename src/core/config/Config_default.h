@@ -53,16 +53,23 @@ R"===(
         "wrmsr": true,
         "cache_qos": false,
         "numa": true,
-        "scratchpad_prefetch_mode": 1
+        "scratchpad_prefetch_mode": 1,
+        "autotune": false
     },
     "cpu": {
         "enabled": true,
         "huge-pages": true,
         "huge-pages-jit": false,
+        "huge-pages-drop-caches": false,
         "hw-aes": null,
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "sched-batch": false,
+        "cgroup": true,
+        "cpuset": null,
+        "adaptive": false,
+        "canary": true,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
@@ -98,6 +105,9 @@ R"===(
             "rig-id": null,
             "nicehash": false,
             "keepalive": false,
+            "ping-interval": 30,
+            "stale-job-timeout": true,
+            "tcp-user-timeout": 0,
             "enabled": true,
             "tls": false,
             "tls-fingerprint": null,
@@ -110,6 +120,7 @@ R"===(
     "print-time": 60,
     "health-print-time": 60,
     "dmi": true,
+    "stats-shm": null,
     "retries": 5,
     "retry-pause": 5,
     "syslog": false,
@@ -99,6 +99,9 @@ static const option options[] = {
     { "no-title",              0, nullptr, IConfig::NoTitleKey            },
     { "pause-on-battery",      0, nullptr, IConfig::PauseOnBatteryKey     },
     { "pause-on-active",       1, nullptr, IConfig::PauseOnActiveKey      },
+#   ifdef XMRIG_OS_UNIX
+    { "stats-shm",             1, nullptr, IConfig::StatsShmKey           },
+#   endif
     { "dns-ipv6",              0, nullptr, IConfig::DnsIPv6Key            },
     { "dns-ttl",               1, nullptr, IConfig::DnsTtlKey             },
     { "spend-secret-key",      1, nullptr, IConfig::SpendSecretKey        },
@@ -140,6 +143,7 @@ static const option options[] = {
     { "no-rdmsr",              0, nullptr, IConfig::RandomXRdmsrKey       },
     { "randomx-cache-qos",     0, nullptr, IConfig::RandomXCacheQoSKey    },
     { "cache-qos",             0, nullptr, IConfig::RandomXCacheQoSKey    },
+    { "randomx-autotune",      0, nullptr, IConfig::RandomXAutotuneKey    },
 #   endif
 #   ifdef XMRIG_FEATURE_OPENCL
     { "opencl",                0, nullptr, IConfig::OclKey                },
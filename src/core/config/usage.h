@@ -108,6 +108,7 @@ static inline const std::string &usage()
     u += "      --randomx-wrmsr=N         write custom value(s) to MSR registers or disable MSR mod (-1)\n";
     u += "      --randomx-no-rdmsr        disable reverting initial MSR values on exit\n";
     u += "      --randomx-cache-qos       enable Cache QoS\n";
+    u += "      --randomx-autotune        measure and store the best RandomX runtime settings for this host\n";
 #   endif
 
 #   ifdef XMRIG_FEATURE_OPENCL
@@ -166,6 +167,10 @@ static inline const std::string &usage()
 #   endif
     u += "      --no-color                disable colored output\n";
     u += "      --verbose                 verbose output\n";
+#   ifdef XMRIG_OS_UNIX
+    u += "      --stats-shm=FILE          publish stats to a read-only shared memory file, example: /dev/shm/xmrig\n";
+    u += "      --stats-read=FILE         print stats from a shared memory file and exit\n";
+#   endif
 
     u += "\nMisc:\n";
 
@@ -174,6 +179,7 @@ static inline const std::string &usage()
     u += "  -V, --version                 output version information and exit\n";
     u += "  -h, --help                    display this help and exit\n";
     u += "      --dry-run                 test configuration and exit\n";
+    u += "      --self-test               check built-in CPU profiles against known CPUs and exit\n";
 
 #   ifdef XMRIG_FEATURE_HWLOC
     u += "      --export-topology         export hwloc topology to a XML file and exit\n";
@@ -0,0 +1,121 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_STATSLAYOUT_H
+#define XMRIG_STATSLAYOUT_H
+
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+/**
+ * Miner stats, values are the same as in the HTTP API summary.
+ * Hashrate is NaN when there is not enough data for the interval yet.
+ */
+struct StatsData
+{
+    static constexpr uint32_t kMaxThreads = 1024;
+
+    enum Dataset : uint32_t {
+        DATASET_NONE,
+        DATASET_INIT,
+        DATASET_READY
+    };
+
+    uint64_t timestamp;                 // last update, ms since epoch
+    uint64_t uptime;                    // seconds
+    uint32_t pid;
+    uint32_t paused;
+
+    double hashrate[3];                 // 10s, 60s, 15m
+    double highest;
+
+    uint64_t accepted;
+    uint64_t rejected;
+    uint64_t failures;
+    uint64_t hashes;                    // sum of accepted shares difficulty
+    uint32_t latency;                   // median share latency, ms
+    uint32_t jobLatencyUs;              // median job latency, us
+
+    char algo[32];
+    char pool[256];
+    char jobId[64];
+    uint8_t seed[32];
+    uint64_t height;
+    uint64_t diff;
+
+    uint32_t dataset;
+    uint32_t threads;                   // valid items in thread
+    uint64_t hugePages[2];              // allocated, total
+
+    double thread[kMaxThreads][3];      // per CPU thread hashrate, 10s, 60s, 15m
+};
+
+
+/**
+ * Read-only shared memory segment written by the miner, see doc/API.md.
+ * The miner is the only writer: seq is odd while an update is in progress, readers retry until they get a copy of data with the same even seq before and after.
+ */
+struct StatsLayout
+{
+    static constexpr uint32_t kMagic    = 0x53524d58; // "XMRS"
+    static constexpr uint32_t kVersion  = 2;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                      // sizeof(StatsLayout)
+    uint32_t reserved;
+    std::atomic<uint64_t> seq;
+    StatsData data;
+
+    inline bool isValid() const { return magic == kMagic && version == kVersion && size == sizeof(StatsLayout); }
+
+    inline bool read(StatsData &out, uint32_t retries = 1000) const
+    {
+        for (uint32_t i = 0; i < retries; ++i) {
+            const uint64_t before = seq.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+
+            memcpy(&out, &data, sizeof(out));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (seq.load(std::memory_order_relaxed) == before) {
+                return before > 0;
+            }
+        }
+
+        return false;
+    }
+};
+
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "seq must be lock free to be shared between processes");
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_STATSLAYOUT_H
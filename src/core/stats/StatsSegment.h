@@ -0,0 +1,58 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_STATSSEGMENT_H
+#define XMRIG_STATSSEGMENT_H
+
+
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "core/stats/StatsLayout.h"
+
+
+namespace xmrig {
+
+
+class StatsSegment
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(StatsSegment)
+
+    StatsSegment(const String &path);
+    ~StatsSegment();
+
+    inline bool isOpen() const              { return m_layout != nullptr; }
+    inline const String &path() const       { return m_path; }
+
+    StatsData *begin();
+    void commit();
+
+    static int print(const char *path);
+
+private:
+    const String m_path;
+    int m_fd                = -1;
+    StatsLayout *m_layout   = nullptr;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_STATSSEGMENT_H
@@ -0,0 +1,202 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "core/stats/StatsSegment.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Process.h"
+
+
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <fcntl.h>
+#include <new>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace xmrig {
+
+
+static void printHashrate(const char *name, const double (&hashrate)[3])
+{
+    printf("%-12s", name);
+
+    for (double value : hashrate) {
+        if (std::isnan(value)) {
+            printf(" %10s", "n/a");
+        }
+        else {
+            printf(" %10.2f", value);
+        }
+    }
+
+    printf("\n");
+}
+
+
+} // namespace xmrig
+
+
+xmrig::StatsSegment::StatsSegment(const String &path) :
+    m_path(path)
+{
+    // The segment usually lives in world writable /dev/shm, so a symlink or a file planted by another user must not be followed or reused.
+    m_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW, 0644);
+    if (m_fd < 0) {
+        LOG_ERR("%s " RED("failed to open stats segment ") RED_BOLD("\"%s\"") RED(": %s"), Tags::miner(), path.data(), strerror(errno));
+
+        return;
+    }
+
+    struct stat st{};
+    if (fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid()) {
+        LOG_ERR("%s " RED("stats segment ") RED_BOLD("\"%s\"") RED(" is not a regular file owned by this user"), Tags::miner(), path.data());
+
+        close(m_fd);
+        m_fd = -1;
+
+        return;
+    }
+
+    if (flock(m_fd, LOCK_EX | LOCK_NB) != 0) {
+        LOG_ERR("%s " RED("stats segment ") RED_BOLD("\"%s\"") RED(" is used by another process"), Tags::miner(), path.data());
+
+        return;
+    }
+
+    void *memory = MAP_FAILED;
+    if (ftruncate(m_fd, sizeof(StatsLayout)) == 0) {
+        memory = mmap(nullptr, sizeof(StatsLayout), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    }
+
+    if (memory == MAP_FAILED) {
+        LOG_ERR("%s " RED("failed to map stats segment ") RED_BOLD("\"%s\"") RED(": %s"), Tags::miner(), path.data(), strerror(errno));
+
+        return;
+    }
+
+    m_layout            = new (memory) StatsLayout();
+    m_layout->version   = StatsLayout::kVersion;
+    m_layout->size      = sizeof(StatsLayout);
+    m_layout->data.pid  = static_cast<uint32_t>(Process::pid());
+
+    std::atomic_thread_fence(std::memory_order_release);
+    m_layout->magic     = StatsLayout::kMagic;
+}
+
+
+xmrig::StatsSegment::~StatsSegment()
+{
+    if (m_layout) {
+        munmap(m_layout, sizeof(StatsLayout));
+        unlink(m_path);
+    }
+
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+
+xmrig::StatsData *xmrig::StatsSegment::begin()
+{
+    if (!m_layout) {
+        return nullptr;
+    }
+
+    m_layout->seq.store(m_layout->seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    return &m_layout->data;
+}
+
+
+void xmrig::StatsSegment::commit()
+{
+    m_layout->seq.store(m_layout->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+
+int xmrig::StatsSegment::print(const char *path)
+{
+    if (!path) {
+        printf("usage: --stats-read=<path>\n");
+
+        return 1;
+    }
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat st{};
+
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size != static_cast<off_t>(sizeof(StatsLayout))) {
+        printf("\"%s\" is not a stats segment of this version\n", path);
+
+        if (fd >= 0) {
+            close(fd);
+        }
+
+        return 1;
+    }
+
+    void *memory = mmap(nullptr, sizeof(StatsLayout), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (memory == MAP_FAILED) {
+        printf("failed to map \"%s\": %s\n", path, strerror(errno));
+
+        return 1;
+    }
+
+    const auto layout = static_cast<const StatsLayout *>(memory);
+    StatsData data{};
+
+    const bool ok = layout->isValid() && layout->read(data);
+    munmap(memory, sizeof(StatsLayout));
+
+    if (!ok) {
+        printf("no data in \"%s\"\n", path);
+
+        return 1;
+    }
+
+    printf("%-12s %u%s\n", "pid", data.pid, data.paused ? " (paused)" : "");
+    printf("%-12s %" PRIu64 " s\n", "uptime", data.uptime);
+    printf("%-12s %s %s\n", "pool", data.pool, data.algo);
+    printf("%-12s %s height %" PRIu64 " diff %" PRIu64 "\n", "job", data.jobId, data.height, data.diff);
+    printf("%-12s %" PRIu64 "/%" PRIu64 " failures %" PRIu64 " hashes %" PRIu64 "\n", "shares", data.accepted, data.rejected, data.failures, data.hashes);
+    printf("%-12s %u ms job %.2f ms\n", "latency", data.latency, data.jobLatencyUs / 1000.0);
+    printf("%-12s %s huge pages %" PRIu64 "/%" PRIu64 "\n", "dataset", data.dataset == StatsData::DATASET_READY ? "ready" : (data.dataset == StatsData::DATASET_INIT ? "init" : "none"), data.hugePages[0], data.hugePages[1]);
+
+    printHashrate("hashrate", data.hashrate);
+
+    char name[16];
+    for (uint32_t i = 0; i < data.threads && i < StatsData::kMaxThreads; ++i) {
+        snprintf(name, sizeof(name), "  #%u", i);
+        printHashrate(name, data.thread[i]);
+    }
+
+    printf("%-12s %.2f\n", "highest", data.highest);
+
+    return 0;
+}
@@ -18,6 +18,8 @@
 
 #include "crypto/common/LinuxMemory.h"
 #include "3rdparty/fmt/core.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "crypto/common/VirtualMemory.h"
 
 
@@ -25,11 +27,13 @@
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <unistd.h>
 
 
 namespace xmrig {
 
 
+static bool dropCachesEnabled = false;
 static std::mutex mutex;
 constexpr size_t twoMiB = 2U * 1024U * 1024U;
 constexpr size_t oneGiB = 1024U * 1024U * 1024U;
@@ -49,6 +53,27 @@ static inline int64_t nr_hugepages(uint32_t node, size_t hugePageSize)
 } // namespace xmrig
 
 
+bool xmrig::LinuxMemory::compact(uint32_t node)
+{
+    return write(fmt::format("/sys/devices/system/node/node{}/compact", node).c_str(), 1) || write("/proc/sys/vm/compact_memory", 1);
+}
+
+
+bool xmrig::LinuxMemory::dropCaches()
+{
+    if (!dropCachesEnabled) {
+        return false;
+    }
+
+    LOG_WARN("%s " YELLOW("huge pages are short, drop clean page cache of the whole system"), Tags::cpu());
+
+    sync();
+
+    // Only clean page cache is dropped, dentries and inodes are kept.
+    return write("/proc/sys/vm/drop_caches", 1);
+}
+
+
 bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize)
 {
     std::lock_guard<std::mutex> lock(mutex);
@@ -60,7 +85,26 @@ bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize
         return false;
     }
 
-    return write_nr_hugepages(node, hugePageSize, std::max<size_t>(nr_hugepages(node, hugePageSize), 0) + (required - available));
+    const int64_t target = std::max<int64_t>(nr_hugepages(node, hugePageSize), 0) + static_cast<int64_t>(required - available);
+    if (!write_nr_hugepages(node, hugePageSize, target)) {
+        return false;
+    }
+
+    // Kernel silently reserves fewer pages than requested when memory is fragmented,
+    // compact the node and then, only if enabled by config, drop clean page cache before giving up.
+    for (int attempt = 0; attempt < 2 && nr_hugepages(node, hugePageSize) < target; ++attempt) {
+        if ((attempt == 0 ? compact(node) : dropCaches()) && !write_nr_hugepages(node, hugePageSize, target)) {
+            break;
+        }
+    }
+
+    return nr_hugepages(node, hugePageSize) >= target;
+}
+
+
+void xmrig::LinuxMemory::setDropCaches(bool enable)
+{
+    dropCachesEnabled = enable;
 }
 
 
@@ -30,7 +30,10 @@ namespace xmrig {
 class LinuxMemory
 {
 public:
+    static bool compact(uint32_t node);
+    static bool dropCaches();
     static bool reserve(size_t size, uint32_t node, size_t hugePageSize);
+    static void setDropCaches(bool enable);
 
     static bool write(const char *path, uint64_t value);
     static int64_t read(const char *path);
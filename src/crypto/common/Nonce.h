@@ -37,6 +37,7 @@ public:
     };
 
 
+    static inline uint64_t counter(uint8_t index)                       { return m_nonces[index].load(std::memory_order_relaxed); }
     static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
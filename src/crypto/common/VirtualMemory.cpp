@@ -74,6 +74,20 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
         return;
     }
 
+    if (hugePages && m_size >= kProgressiveMinSize && allocateProgressive()) {
+        return;
+    }
+
+    // The heap can hand out pages that another thread has already touched on another node, fresh pages are placed by the calling thread.
+    if (Cpu::info()->nodes() > 1) {
+        m_scratchpad = static_cast<uint8_t*>(allocateLocalMemory(m_size));
+        if (m_scratchpad) {
+            m_flags.set(FLAG_LOCAL, true);
+
+            return;
+        }
+    }
+
     m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, alignSize));
 }
 
@@ -88,7 +102,7 @@ xmrig::VirtualMemory::~VirtualMemory()
         std::lock_guard<std::mutex> lock(mutex);
         pool->release(m_node);
     }
-    else if (isHugePages() || isOneGbPages()) {
+    else if (isHugePages() || isOneGbPages() || m_flags.test(FLAG_PROGRESSIVE) || m_flags.test(FLAG_LOCAL)) {
         freeLargePagesMemory();
     }
     else {
@@ -108,6 +122,12 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
     return 0;
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOf(int64_t)
+{
+    return 0;
+}
 #endif
 
 
@@ -25,10 +25,12 @@
 #include "crypto/common/HugePagesInfo.h"
 
 
+#include <atomic>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 
 namespace xmrig {
@@ -41,6 +43,8 @@ public:
 
     constexpr static size_t kDefaultHugePageSize    = 2U * 1024U * 1024U;
     constexpr static size_t kOneGiB                 = 1024U * 1024U * 1024U;
+    constexpr static size_t kProgressiveMinSize     = 64U * 1024U * 1024U;
+    constexpr static uint32_t kMaxCompactions       = 5;
 
     VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64);
     ~VirtualMemory();
@@ -49,21 +53,27 @@ public:
     inline bool isOneGbPages() const                                { return m_flags.test(FLAG_1GB_PAGES); }
     inline size_t size() const                                      { return m_size; }
     inline size_t capacity() const                                  { return m_capacity; }
+    inline size_t hugeSegments() const                              { return m_hugeSegments.load(std::memory_order_relaxed); }
     inline uint8_t *raw() const                                     { return m_scratchpad; }
     inline uint8_t *scratchpad() const                              { return m_scratchpad; }
 
     inline static void flushInstructionCache(void *p1, void *p2)    { flushInstructionCache(p1, static_cast<uint8_t*>(p2) - static_cast<uint8_t*>(p1)); }
 
+    bool upgradeHugePages();
     HugePagesInfo hugePages() const;
+    size_t discard();
 
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
     static bool protectRW(void *p, size_t size);
     static bool protectRWX(void *p, size_t size);
     static bool protectRX(void *p, size_t size);
+    static size_t remoteBytes(const void *p, size_t size, uint32_t node);
     static uint32_t bindToNUMANode(int64_t affinity);
+    static uint32_t nodeOf(int64_t affinity);
     static void *allocateExecutableMemory(size_t size, bool hugePages);
     static void *allocateLargePagesMemory(size_t size);
+    static void *allocateLocalMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
@@ -80,6 +90,8 @@ private:
         FLAG_1GB_PAGES,
         FLAG_LOCK,
         FLAG_EXTERNAL,
+        FLAG_PROGRESSIVE,
+        FLAG_LOCAL,
         FLAG_MAX
     };
 
@@ -87,6 +99,7 @@ private:
 
     bool allocateLargePagesMemory();
     bool allocateOneGbPagesMemory();
+    bool allocateProgressive();
     void freeLargePagesMemory();
 
     static size_t m_hugePageSize;
@@ -94,7 +107,12 @@ private:
     const size_t m_size;
     const uint32_t m_node;
     size_t m_capacity;
+    bool m_collapse = false;
+    uint32_t m_compactions  = 0;
+    uint32_t m_compactDelay = 0;
+    std::atomic<size_t> m_hugeSegments{0};
     std::bitset<FLAG_MAX> m_flags;
+    std::vector<bool> m_hugetlb;
     uint8_t *m_scratchpad = nullptr;
 };
 
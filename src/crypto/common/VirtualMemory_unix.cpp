@@ -22,10 +22,16 @@
 #include "crypto/common/portable/mm_malloc.h"
 
 
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <string>
 #include <sys/mman.h>
+#include <unistd.h>
 
 
 #ifdef XMRIG_OS_APPLE
@@ -45,6 +51,12 @@
 
 #ifdef XMRIG_OS_LINUX
 #   include "crypto/common/LinuxMemory.h"
+#   include <sys/syscall.h>
+#endif
+
+
+#ifndef MADV_COLLAPSE
+#   define MADV_COLLAPSE 25
 #endif
 
 
@@ -82,6 +94,125 @@ static inline int hugePagesFlag(size_t size)
 #endif
 
 
+#ifdef XMRIG_OS_LINUX
+static size_t anonHugePages(const uint8_t *p, size_t size)
+{
+    const auto begin = reinterpret_cast<uintptr_t>(p);
+    const auto end   = begin + size;
+
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    size_t overlap = 0;
+    size_t vma     = 0;
+    size_t total   = 0;
+
+    while (std::getline(smaps, line)) {
+        uintptr_t first = 0;
+        uintptr_t last  = 0;
+
+        if (sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR " ", &first, &last) == 2) {
+            vma     = last - first;
+            overlap = first < end && last > begin ? std::min(last, end) - std::max(first, begin) : 0;
+        }
+        else if (overlap && line.compare(0, 14, "AnonHugePages:") == 0) {
+            // A VMA can extend beyond the range (merged with a neighbour mapping), only its overlapping share is counted,
+            // assuming huge pages are spread evenly over the VMA.
+            const size_t pages = strtoull(line.c_str() + 14, nullptr, 10) * 1024;
+            total += overlap == vma ? pages : static_cast<size_t>(static_cast<double>(pages) * overlap / vma);
+        }
+    }
+
+    return total;
+}
+#endif
+
+
+bool xmrig::VirtualMemory::upgradeHugePages()
+{
+#   ifdef XMRIG_OS_LINUX
+    if (!m_collapse || hugePageSize() != kDefaultHugePageSize) {
+        return false;
+    }
+
+    const size_t page = hugePageSize();
+    size_t hugetlb    = 0;
+    size_t failed     = 0;
+
+    // Small page segments are collapsed in place into transparent huge pages, the content is preserved
+    // so it is safe while mining threads read the dataset.
+    for (size_t i = 0; i < m_hugetlb.size(); ++i) {
+        if (m_hugetlb[i]) {
+            ++hugetlb;
+        }
+        else if (madvise(m_scratchpad + i * page, page, MADV_COLLAPSE) != 0) {
+            if (errno == EINVAL) {
+                m_collapse = false;
+                break;
+            }
+
+            ++failed;
+        }
+    }
+
+    // Compaction works on the whole node, so it backs off exponentially (1, 2, 4... upgrade passes) while segments still
+    // fail to collapse, and stops after kMaxCompactions in a row.
+    if (!failed) {
+        m_compactions  = 0;
+        m_compactDelay = 0;
+    }
+    else if (m_compactions < kMaxCompactions && ++m_compactDelay >= (1U << m_compactions)) {
+        LinuxMemory::compact(m_node);
+
+        m_compactDelay = 0;
+        ++m_compactions;
+    }
+
+    const size_t segments = std::min(hugetlb + anonHugePages(m_scratchpad, m_size) / page, m_hugetlb.size());
+
+    return m_hugeSegments.exchange(segments) != segments;
+#   else
+    return false;
+#   endif
+}
+
+
+size_t xmrig::VirtualMemory::discard()
+{
+    // Huge pages from the pool are locked and can't be faulted back in safely, only regular and transparent huge pages are released.
+    if (!m_scratchpad || isHugePages() || isOneGbPages() || m_flags.test(FLAG_EXTERNAL)) {
+        return 0;
+    }
+
+    if (m_flags.test(FLAG_PROGRESSIVE)) {
+        const size_t page = hugePageSize();
+        size_t i = 0;
+
+        while (i < m_hugetlb.size() && m_hugetlb[i]) {
+            ++i;
+        }
+
+        if (i == m_hugetlb.size() || madvise(m_scratchpad + i * page, m_size - i * page, MADV_DONTNEED) != 0) {
+            return 0;
+        }
+
+        m_hugeSegments = i;
+        m_collapse     = false;
+
+        return m_size - i * page;
+    }
+
+    const auto page  = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto begin = align(reinterpret_cast<uintptr_t>(m_scratchpad), page);
+    const auto end   = (reinterpret_cast<uintptr_t>(m_scratchpad) + m_size) / page * page;
+
+    if (end <= begin || madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED) != 0) {
+        return 0;
+    }
+
+    return end - begin;
+}
+
+
 bool xmrig::VirtualMemory::isHugepagesAvailable()
 {
 #   ifdef XMRIG_OS_LINUX
@@ -139,6 +270,47 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+size_t xmrig::VirtualMemory::remoteBytes(const void *p, size_t size, uint32_t node)
+{
+#   ifdef XMRIG_OS_LINUX
+    if (!p || !size || Cpu::info()->nodes() < 2) {
+        return 0;
+    }
+
+    constexpr size_t kBatch = 512;
+    const auto page         = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto end          = reinterpret_cast<uintptr_t>(p) + size;
+    auto addr               = reinterpret_cast<uintptr_t>(p) & ~(page - 1);
+    size_t remote           = 0;
+
+    void *pages[kBatch];
+    int status[kBatch];
+
+    // move_pages() without target nodes only reports where each page lives, pages that were never touched report a negative status.
+    while (addr < end) {
+        size_t count = 0;
+        for (; count < kBatch && addr < end; ++count, addr += page) {
+            pages[count] = reinterpret_cast<void *>(addr);
+        }
+
+        if (syscall(SYS_move_pages, 0, count, pages, nullptr, status, 0) != 0) {
+            return 0;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (status[i] >= 0 && static_cast<uint32_t>(status[i]) != node) {
+                remote += page;
+            }
+        }
+    }
+
+    return remote;
+#   else
+    return 0;
+#   endif
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
 #   if defined(XMRIG_OS_APPLE)
@@ -189,6 +361,14 @@ void *xmrig::VirtualMemory::allocateLargePagesMemory(size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateLocalMemory(size_t size)
+{
+    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    return mem == MAP_FAILED ? nullptr : mem;
+}
+
+
 void *xmrig::VirtualMemory::allocateOneGbPagesMemory(size_t size)
 {
 #   ifdef XMRIG_OS_LINUX
@@ -273,6 +453,63 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 }
 
 
+bool xmrig::VirtualMemory::allocateProgressive()
+{
+#   ifdef XMRIG_OS_LINUX
+    const size_t page     = hugePageSize();
+    const size_t reserved = m_size + page;
+
+    // Address space aligned to the huge page size, each segment is replaced by a huge page while the pool has them.
+    auto base = static_cast<uint8_t *>(mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    auto p = reinterpret_cast<uint8_t *>(align(reinterpret_cast<uintptr_t>(base), page));
+    if (p != base) {
+        munmap(base, static_cast<size_t>(p - base));
+    }
+
+    munmap(p + m_size, static_cast<size_t>(base + reserved - (p + m_size)));
+
+    const size_t count = m_size / page;
+    size_t hugetlb     = 0;
+
+    m_hugetlb.assign(count, false);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t *segment = p + i * page;
+
+        if (mmap(segment, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(page), -1, 0) != MAP_FAILED) {
+            m_hugetlb[i] = true;
+            ++hugetlb;
+
+            continue;
+        }
+
+        // Failed MAP_FIXED may leave a hole, restore small pages for the rest of the range.
+        if (mmap(segment, m_size - i * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
+            munmap(p, m_size);
+
+            return false;
+        }
+
+        madvise(segment, m_size - i * page, MADV_HUGEPAGE);
+        break;
+    }
+
+    m_scratchpad   = p;
+    m_hugeSegments = hugetlb;
+    m_collapse     = hugetlb < count;
+    m_flags.set(FLAG_PROGRESSIVE, true);
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
     if (m_flags.test(FLAG_LOCK)) {
@@ -150,6 +150,18 @@ static BOOL TrySetLockPagesPrivilege() {
 } // namespace xmrig
 
 
+bool xmrig::VirtualMemory::upgradeHugePages()
+{
+    return false;
+}
+
+
+size_t xmrig::VirtualMemory::discard()
+{
+    return 0;
+}
+
+
 bool xmrig::VirtualMemory::isHugepagesAvailable()
 {
     return hugepagesAvailable;
@@ -186,6 +198,12 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+size_t xmrig::VirtualMemory::remoteBytes(const void *, size_t, uint32_t)
+{
+    return 0;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
     void* result = nullptr;
@@ -215,6 +233,12 @@ void *xmrig::VirtualMemory::allocateLargePagesMemory(size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateLocalMemory(size_t size)
+{
+    return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+}
+
+
 void *xmrig::VirtualMemory::allocateOneGbPagesMemory(size_t)
 {
     return nullptr;
@@ -260,6 +284,12 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 }
 
 
+bool xmrig::VirtualMemory::allocateProgressive()
+{
+    return false;
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
     freeLargePagesMemory(m_scratchpad, m_size);
@@ -25,16 +25,17 @@
  */
 
 
+#define XMRIG_KP_MIX_IMPL
+
 #include "backend/cpu/Cpu.h"
 #include "crypto/kawpow/KPHash.h"
 #include "crypto/kawpow/KPCache.h"
+#include "crypto/kawpow/KPMix.h"
 #include "3rdparty/libethash/ethash.h"
 #include "3rdparty/libethash/ethash_internal.h"
 #include "3rdparty/libethash/data_sizes.h"
 
-#ifdef _MSC_VER
-#include <intrin.h>
-#endif
+#include <utility>
 
 namespace xmrig {
 
@@ -83,139 +84,33 @@ static inline uint32_t kiss99(uint32_t& z, uint32_t& w, uint32_t& jsr, uint32_t&
 }
 
 
-static inline uint32_t rotl(uint32_t n, uint32_t c)
-{
-#ifdef _MSC_VER
-    return _rotl(n, c);
-#else
-    c &= 31;
-    uint32_t neg_c = (uint32_t)(-(int32_t)c);
-    return (n << c) | (n >> (neg_c & 31));
-#endif
-}
-
-
-static inline uint32_t rotr(uint32_t n, uint32_t c)
-{
-#ifdef _MSC_VER
-    return _rotr(n, c);
-#else
-    c &= 31;
-    uint32_t neg_c = (uint32_t)(-(int32_t)c);
-    return (n >> c) | (n << (neg_c & 31));
-#endif
-}
-
-
-static inline void random_merge(uint32_t& a, uint32_t b, uint32_t selector)
+static kp_mix_func selectMix()
 {
-    const uint32_t x = (selector >> 16) % 31 + 1;
-    switch (selector % 4)
-    {
-    case 0:
-        a = (a * 33) + b;
-        break;
-    case 1:
-        a = (a ^ b) * 33;
-        break;
-    case 2:
-        a = rotl(a, x) ^ b;
-        break;
-    case 3:
-        a = rotr(a, x) ^ b;
-        break;
-    default:
-#ifdef _MSC_VER
-        __assume(false);
-#else
-        __builtin_unreachable();
-#endif
-        break;
+#   ifdef XMRIG_FEATURE_AVX2
+    if (Cpu::info()->has(ICpuInfo::FLAG_AVX512F)) {
+        return kp_mix_avx512;
     }
-}
-
-
-static inline uint32_t clz(uint32_t a)
-{
-#ifdef _MSC_VER
-    unsigned long index;
-    _BitScanReverse(&index, a);
-    return a ? (31 - index) : 32;
-#else
-    return a ? (uint32_t)__builtin_clz(a) : 32;
-#endif
-}
-
-
-static inline uint32_t popcount(uint32_t a)
-{
-#ifdef _MSC_VER
-    return __popcnt(a);
-#else
-    return __builtin_popcount(a);
-#endif
-}
 
+    if (Cpu::info()->hasAVX2()) {
+        return kp_mix_avx2;
+    }
+#   endif
 
-// Taken from https://en.wikipedia.org/wiki/Hamming_weight
-static inline uint32_t popcount_soft(uint64_t x)
-{
-    constexpr uint64_t m1 = 0x5555555555555555ull;
-    constexpr uint64_t m2 = 0x3333333333333333ull;
-    constexpr uint64_t m4 = 0x0f0f0f0f0f0f0f0full;
-    constexpr uint64_t h01 = 0x0101010101010101ull;
-
-    x -= (x >> 1) & m1;             //put count of each 2 bits into those 2 bits
-    x = (x & m2) + ((x >> 2) & m2); //put count of each 4 bits into those 4 bits
-    x = (x + (x >> 4)) & m4;        //put count of each 8 bits into those 8 bits
-    return (x * h01) >> 56;         //returns left 8 bits of x + (x<<8) + (x<<16) + (x<<24) + ...
+    return kp_mix_generic;
 }
 
 
-static inline uint32_t random_math(uint32_t a, uint32_t b, uint32_t selector, bool has_popcnt)
+void kp_mix_generic(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z, uint32_t w, uint32_t (&lane_hash)[KPHash::LANES])
 {
-    switch (selector % 11)
-    {
-    case 0:
-        return a + b;
-    case 1:
-        return a * b;
-    case 2:
-        return (uint64_t(a) * b) >> 32;
-    case 3:
-        return (a < b) ? a : b;
-    case 4:
-        return rotl(a, b);
-    case 5:
-        return rotr(a, b);
-    case 6:
-        return a & b;
-    case 7:
-        return a | b;
-    case 8:
-        return a ^ b;
-    case 9:
-        return clz(a) + clz(b);
-    case 10:
-        if (has_popcnt)
-            return popcount(a) + popcount(b);
-        else
-            return popcount_soft(a) + popcount_soft(b);
-    default:
-#ifdef _MSC_VER
-        __assume(false);
-#else
-        __builtin_unreachable();
-#endif
-        break;
-    }
+    kp::mix(prog, light, l1, num_items, z, w, lane_hash);
 }
 
 
 void KPHash::calculate(const KPCache& light_cache, uint32_t block_height, const uint8_t (&header_hash)[32], uint64_t nonce, uint32_t (&output)[8], uint32_t (&mix_hash)[8])
 {
+    static const kp_mix_func mix = selectMix();
+
     uint32_t keccak_state[25];
-    uint32_t mix[LANES][REGS];
 
     memcpy(keccak_state, header_hash, sizeof(header_hash));
     memcpy(keccak_state + 8, &nonce, sizeof(nonce));
@@ -223,30 +118,18 @@ void KPHash::calculate(const KPCache& light_cache, uint32_t block_height, const
 
     ethash_keccakf800(keccak_state);
 
-    uint32_t z = fnv1a(fnv_offset_basis, keccak_state[0]);
-    uint32_t w = fnv1a(z, keccak_state[1]);
-    uint32_t jsr, jcong;
-
-    for (uint32_t l = 0; l < LANES; ++l) {
-        uint32_t z1 = z;
-        uint32_t w1 = w;
-        jsr = fnv1a(w, l);
-        jcong = fnv1a(jsr, l);
-
-        for (uint32_t r = 0; r < REGS; ++r) {
-            mix[l][r] = kiss99(z1, w1, jsr, jcong);
-        }
-    }
+    const uint32_t seed_z = fnv1a(fnv_offset_basis, keccak_state[0]);
+    const uint32_t seed_w = fnv1a(seed_z, keccak_state[1]);
 
     const uint32_t prog_number = block_height / PERIOD_LENGTH;
 
     uint32_t dst_seq[REGS];
     uint32_t src_seq[REGS];
 
-    z = fnv1a(fnv_offset_basis, prog_number);
-    w = fnv1a(z, 0);
-    jsr = fnv1a(w, prog_number);
-    jcong = fnv1a(jsr, 0);
+    uint32_t z     = fnv1a(fnv_offset_basis, prog_number);
+    uint32_t w     = fnv1a(z, 0);
+    uint32_t jsr   = fnv1a(w, prog_number);
+    uint32_t jcong = fnv1a(jsr, 0);
 
     for (uint32_t i = 0; i < REGS; ++i)
     {
@@ -260,12 +143,43 @@ void KPHash::calculate(const KPCache& light_cache, uint32_t block_height, const
         std::swap(src_seq[i - 1], src_seq[kiss99(z, w, jsr, jcong) % i]);
     }
 
-    const uint32_t epoch = light_cache.epoch();
-    const uint32_t num_items = static_cast<uint32_t>(dag_sizes[epoch] / ETHASH_MIX_BYTES / 2);
+    KPProgram prog;
+    uint32_t dst_counter = 0;
+    uint32_t src_counter = 0;
 
-    constexpr size_t num_words_per_lane = 256 / (sizeof(uint32_t) * LANES);
     constexpr int max_operations = (CNT_CACHE > CNT_MATH) ? CNT_CACHE : CNT_MATH;
 
+    for (uint32_t i = 0; i < max_operations; ++i) {
+        if (i < CNT_CACHE) {
+            prog.cacheSrc[i] = src_seq[(src_counter++) % REGS];
+            prog.cacheDst[i] = dst_seq[(dst_counter++) % REGS];
+            prog.cacheSel[i] = kiss99(z, w, jsr, jcong);
+        }
+
+        if (i < CNT_MATH) {
+            const uint32_t src_rnd = kiss99(z, w, jsr, jcong) % (REGS * (REGS - 1));
+            const uint32_t src1 = src_rnd % REGS;
+            uint32_t src2 = src_rnd / REGS;
+            if (src2 >= src1) {
+                ++src2;
+            }
+
+            prog.mathSrc1[i] = src1;
+            prog.mathSrc2[i] = src2;
+            prog.mathSel1[i] = kiss99(z, w, jsr, jcong);
+            prog.mathDst[i]  = dst_seq[(dst_counter++) % REGS];
+            prog.mathSel2[i] = kiss99(z, w, jsr, jcong);
+        }
+    }
+
+    for (uint32_t i = 0; i < KPProgram::kDagWords; ++i) {
+        prog.dagDst[i] = (i == 0) ? 0 : dst_seq[(dst_counter++) % REGS];
+        prog.dagSel[i] = kiss99(z, w, jsr, jcong);
+    }
+
+    const uint32_t epoch = light_cache.epoch();
+    const uint32_t num_items = static_cast<uint32_t>(dag_sizes[epoch] / ETHASH_MIX_BYTES / 2);
+
     ethash_light cache;
     cache.cache = light_cache.data();
     cache.cache_size = light_cache.size();
@@ -274,81 +188,8 @@ void KPHash::calculate(const KPCache& light_cache, uint32_t block_height, const
     cache.num_parent_nodes = cache.cache_size / sizeof(node);
     KPCache::calculate_fast_mod_data(cache.num_parent_nodes, cache.reciprocal, cache.increment, cache.shift);
 
-    uint32_t z0 = z;
-    uint32_t w0 = w;
-    uint32_t jsr0 = jsr;
-    uint32_t jcong0 = jcong;
-
-    const bool has_popcnt = Cpu::info()->has(ICpuInfo::FLAG_POPCNT);
-
-    for (uint32_t r = 0; r < ETHASH_ACCESSES; ++r) {
-        uint32_t item_index = (mix[r % LANES][0] % num_items) * 4;
-
-        node item[4];
-        ethash_calculate_dag_item4_opt(item, item_index, KPCache::num_dataset_parents, &cache);
-
-        uint32_t dst_counter = 0;
-        uint32_t src_counter = 0;
-
-        z = z0;
-        w = w0;
-        jsr = jsr0;
-        jcong = jcong0;
-
-        for (uint32_t i = 0; i < max_operations; ++i) {
-            if (i < CNT_CACHE) {
-                const uint32_t src = src_seq[(src_counter++) % REGS];
-                const uint32_t dst = dst_seq[(dst_counter++) % REGS];
-                const uint32_t sel = kiss99(z, w, jsr, jcong);
-                for (uint32_t j = 0; j < LANES; ++j) {
-                    random_merge(mix[j][dst], light_cache.l1_cache()[mix[j][src] % KPCache::l1_cache_num_items], sel);
-                }
-            }
-
-            if (i < CNT_MATH)
-            {
-                const uint32_t src_rnd = kiss99(z, w, jsr, jcong) % (REGS * (REGS - 1));
-                const uint32_t src1 = src_rnd % REGS;
-                uint32_t src2 = src_rnd / REGS;
-                if (src2 >= src1) {
-                    ++src2;
-                }
-
-                const uint32_t sel1 = kiss99(z, w, jsr, jcong);
-                const uint32_t dst = dst_seq[(dst_counter++) % REGS];
-                const uint32_t sel2 = kiss99(z, w, jsr, jcong);
-
-                for (size_t l = 0; l < LANES; ++l)
-                {
-                    const uint32_t data = random_math(mix[l][src1], mix[l][src2], sel1, has_popcnt);
-                    random_merge(mix[l][dst], data, sel2);
-                }
-            }
-        }
-
-        uint32_t dsts[num_words_per_lane];
-        uint32_t sels[num_words_per_lane];
-        for (uint32_t i = 0; i < num_words_per_lane; ++i) {
-            dsts[i] = (i == 0) ? 0 : dst_seq[(dst_counter++) % REGS];
-            sels[i] = kiss99(z, w, jsr, jcong);
-        }
-
-        for (uint32_t l = 0; l < LANES; ++l) {
-            const uint32_t offset = ((l ^ r) % LANES) * num_words_per_lane;
-            for (size_t i = 0; i < num_words_per_lane; ++i) {
-                random_merge(mix[l][dsts[i]], ((uint32_t*)item)[offset + i], sels[i]);
-            }
-        }
-    }
-
     uint32_t lane_hash[LANES];
-    for (uint32_t l = 0; l < LANES; ++l)
-    {
-        lane_hash[l] = fnv_offset_basis;
-        for (uint32_t i = 0; i < REGS; ++i) {
-            lane_hash[l] = fnv1a(lane_hash[l], mix[l][i]);
-        }
-    }
+    mix(prog, &cache, light_cache.l1_cache(), num_items, seed_z, seed_w, lane_hash);
 
     constexpr uint32_t num_words = 8;
 
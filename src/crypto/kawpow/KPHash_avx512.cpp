@@ -0,0 +1,27 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define XMRIG_KP_MIX_IMPL
+
+#include "crypto/kawpow/KPMix.h"
+
+
+void xmrig::kp_mix_avx512(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z, uint32_t w, uint32_t (&lane_hash)[KPHash::LANES])
+{
+    kp::mix(prog, light, l1, num_items, z, w, lane_hash);
+}
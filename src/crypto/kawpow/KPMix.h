@@ -0,0 +1,276 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_KP_MIX_H
+#define XMRIG_KP_MIX_H
+
+
+#include "crypto/kawpow/KPCache.h"
+#include "crypto/kawpow/KPHash.h"
+#include "3rdparty/libethash/ethash_internal.h"
+
+
+namespace xmrig
+{
+
+
+/**
+ * ProgPoW program for one period: the sequence of cache, math and DAG merge operations.
+ * The KISS99 state is reset for every DAG access, so the sequence is the same for all of them.
+ */
+struct KPProgram
+{
+    static constexpr uint32_t kDagWords = 256 / (sizeof(uint32_t) * KPHash::LANES);
+
+    uint32_t cacheSrc[KPHash::CNT_CACHE];
+    uint32_t cacheDst[KPHash::CNT_CACHE];
+    uint32_t cacheSel[KPHash::CNT_CACHE];
+
+    uint32_t mathSrc1[KPHash::CNT_MATH];
+    uint32_t mathSrc2[KPHash::CNT_MATH];
+    uint32_t mathSel1[KPHash::CNT_MATH];
+    uint32_t mathDst[KPHash::CNT_MATH];
+    uint32_t mathSel2[KPHash::CNT_MATH];
+
+    uint32_t dagDst[kDagWords];
+    uint32_t dagSel[kDagWords];
+};
+
+
+using kp_mix_func = void (*)(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z, uint32_t w, uint32_t (&lane_hash)[KPHash::LANES]);
+
+
+void kp_mix_generic(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z, uint32_t w, uint32_t (&lane_hash)[KPHash::LANES]);
+
+#ifdef XMRIG_FEATURE_AVX2
+void kp_mix_avx2(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z, uint32_t w, uint32_t (&lane_hash)[KPHash::LANES]);
+void kp_mix_avx512(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z, uint32_t w, uint32_t (&lane_hash)[KPHash::LANES]);
+#endif
+
+
+#ifdef XMRIG_KP_MIX_IMPL
+// Everything below is compiled once per instruction set, so it must not use anything with external linkage
+// except the libethash C functions: an inline function built with AVX-512 could be picked by the linker for all callers.
+// All 16 lanes are independent and all of them run the same operation, every operation is a loop over the lanes which
+// the compiler maps to 4, 8 or 16 wide vectors. Registers are stored as mix[reg][lane] to keep these loops contiguous.
+namespace kp {
+
+
+constexpr uint32_t LANES            = KPHash::LANES;
+constexpr uint32_t REGS             = KPHash::REGS;
+constexpr uint32_t l1_items         = static_cast<uint32_t>(KPCache::l1_cache_num_items);
+constexpr uint32_t fnv_prime        = 0x01000193;
+constexpr uint32_t fnv_offset_basis = 0x811c9dc5;
+
+
+static inline uint32_t fnv1a(uint32_t u, uint32_t v)
+{
+    return (u ^ v) * fnv_prime;
+}
+
+
+static inline uint32_t popcount(uint32_t x)
+{
+    x -= (x >> 1) & 0x55555555U;
+    x  = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+    x  = (x + (x >> 4)) & 0x0F0F0F0FU;
+    x += x >> 8;
+    x += x >> 16;
+
+    return x & 0x3F;
+}
+
+
+static inline uint32_t clz(uint32_t x)
+{
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+
+    return 32 - popcount(x);
+}
+
+
+static inline void merge(uint32_t *a, const uint32_t *b, uint32_t sel)
+{
+    const uint32_t x = (sel >> 16) % 31 + 1;
+
+    switch (sel % 4) {
+    case 0:
+        for (uint32_t l = 0; l < LANES; ++l) { a[l] = (a[l] * 33) + b[l]; }
+        break;
+
+    case 1:
+        for (uint32_t l = 0; l < LANES; ++l) { a[l] = (a[l] ^ b[l]) * 33; }
+        break;
+
+    case 2:
+        for (uint32_t l = 0; l < LANES; ++l) { a[l] = ((a[l] << x) | (a[l] >> (32 - x))) ^ b[l]; }
+        break;
+
+    default:
+        for (uint32_t l = 0; l < LANES; ++l) { a[l] = ((a[l] >> x) | (a[l] << (32 - x))) ^ b[l]; }
+        break;
+    }
+}
+
+
+static inline void math(uint32_t *out, const uint32_t *a, const uint32_t *b, uint32_t sel)
+{
+    switch (sel % 11) {
+    case 0:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = a[l] + b[l]; }
+        break;
+
+    case 1:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = a[l] * b[l]; }
+        break;
+
+    case 2:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = static_cast<uint32_t>((static_cast<uint64_t>(a[l]) * b[l]) >> 32); }
+        break;
+
+    case 3:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = a[l] < b[l] ? a[l] : b[l]; }
+        break;
+
+    case 4:
+        for (uint32_t l = 0; l < LANES; ++l) { const uint32_t c = b[l] & 31; out[l] = (a[l] << c) | (a[l] >> ((32 - c) & 31)); }
+        break;
+
+    case 5:
+        for (uint32_t l = 0; l < LANES; ++l) { const uint32_t c = b[l] & 31; out[l] = (a[l] >> c) | (a[l] << ((32 - c) & 31)); }
+        break;
+
+    case 6:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = a[l] & b[l]; }
+        break;
+
+    case 7:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = a[l] | b[l]; }
+        break;
+
+    case 8:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = a[l] ^ b[l]; }
+        break;
+
+    case 9:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = clz(a[l]) + clz(b[l]); }
+        break;
+
+    default:
+        for (uint32_t l = 0; l < LANES; ++l) { out[l] = popcount(a[l]) + popcount(b[l]); }
+        break;
+    }
+}
+
+
+static inline void kiss99(uint32_t *z, uint32_t *w, uint32_t *jsr, uint32_t *jcong, uint32_t *out)
+{
+    for (uint32_t l = 0; l < LANES; ++l) {
+        z[l] = 36969 * (z[l] & 0xffff) + (z[l] >> 16);
+        w[l] = 18000 * (w[l] & 0xffff) + (w[l] >> 16);
+
+        jcong[l] = 69069 * jcong[l] + 1234567;
+
+        jsr[l] ^= (jsr[l] << 17);
+        jsr[l] ^= (jsr[l] >> 13);
+        jsr[l] ^= (jsr[l] << 5);
+
+        out[l] = (((z[l] << 16) + w[l]) ^ jcong[l]) + jsr[l];
+    }
+}
+
+
+static inline void mix(const KPProgram &prog, ethash_light_t light, const uint32_t *l1, uint32_t num_items, uint32_t z0, uint32_t w0, uint32_t (&lane_hash)[LANES])
+{
+    alignas(64) uint32_t mix[REGS][LANES];
+    alignas(64) uint32_t z[LANES];
+    alignas(64) uint32_t w[LANES];
+    alignas(64) uint32_t jsr[LANES];
+    alignas(64) uint32_t jcong[LANES];
+    alignas(64) uint32_t data[LANES];
+
+    for (uint32_t l = 0; l < LANES; ++l) {
+        z[l]     = z0;
+        w[l]     = w0;
+        jsr[l]   = fnv1a(w0, l);
+        jcong[l] = fnv1a(jsr[l], l);
+    }
+
+    for (uint32_t r = 0; r < REGS; ++r) {
+        kiss99(z, w, jsr, jcong, mix[r]);
+    }
+
+    constexpr uint32_t max_operations = (KPHash::CNT_CACHE > KPHash::CNT_MATH) ? KPHash::CNT_CACHE : KPHash::CNT_MATH;
+
+    for (uint32_t r = 0; r < ETHASH_ACCESSES; ++r) {
+        node item[4];
+        ethash_calculate_dag_item4_opt(item, (mix[0][r % LANES] % num_items) * 4, KPCache::num_dataset_parents, light);
+
+        for (uint32_t i = 0; i < max_operations; ++i) {
+            if (i < KPHash::CNT_CACHE) {
+                const uint32_t *src = mix[prog.cacheSrc[i]];
+
+                for (uint32_t l = 0; l < LANES; ++l) {
+                    data[l] = l1[src[l] % l1_items];
+                }
+
+                merge(mix[prog.cacheDst[i]], data, prog.cacheSel[i]);
+            }
+
+            if (i < KPHash::CNT_MATH) {
+                math(data, mix[prog.mathSrc1[i]], mix[prog.mathSrc2[i]], prog.mathSel1[i]);
+                merge(mix[prog.mathDst[i]], data, prog.mathSel2[i]);
+            }
+        }
+
+        // The four DAG items are read as one array of LANES * kDagWords words.
+        const auto words = reinterpret_cast<const uint32_t *>(item);
+
+        for (uint32_t i = 0; i < KPProgram::kDagWords; ++i) {
+            for (uint32_t l = 0; l < LANES; ++l) {
+                data[l] = words[((l ^ r) % LANES) * KPProgram::kDagWords + i];
+            }
+
+            merge(mix[prog.dagDst[i]], data, prog.dagSel[i]);
+        }
+    }
+
+    for (uint32_t l = 0; l < LANES; ++l) {
+        lane_hash[l] = fnv_offset_basis;
+    }
+
+    for (uint32_t i = 0; i < REGS; ++i) {
+        for (uint32_t l = 0; l < LANES; ++l) {
+            lane_hash[l] = fnv1a(lane_hash[l], mix[i][l]);
+        }
+    }
+}
+
+
+} // namespace kp
+#endif
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_KP_MIX_H
@@ -51,6 +51,7 @@ void randomx_set_optimized_dataset_init(int value)
 namespace ARMV8A {
 
 constexpr uint32_t B           = 0x14000000;
+constexpr uint32_t BL          = 0x94000000;
 constexpr uint32_t EOR         = 0xCA000000;
 constexpr uint32_t EOR32       = 0x4A000000;
 constexpr uint32_t ADD         = 0x8B000000;
@@ -102,10 +103,35 @@ static size_t CalcDatasetItemSize()
 	((uint8_t*)randomx_calc_dataset_item_aarch64_end - (uint8_t*)randomx_calc_dataset_item_aarch64_store_result);
 }
 
+static size_t CalcDatasetItemX2Size()
+{
+	return
+	// Dataset init loop
+	((uint8_t*)randomx_init_dataset_aarch64_x2_end - (uint8_t*)randomx_init_dataset_aarch64_x2) +
+	// Prologue
+	((uint8_t*)randomx_calc_dataset_item_aarch64_x2_prefetch - (uint8_t*)randomx_calc_dataset_item_aarch64_x2) +
+	// Main loop
+	RandomX_ConfigurationBase::CacheAccesses * (
+		// Main loop prologue
+		((uint8_t*)randomx_calc_dataset_item_aarch64_x2_mix - ((uint8_t*)randomx_calc_dataset_item_aarch64_x2_prefetch)) + 4 +
+		// Inner main loop (instructions for both items)
+		((RandomX_ConfigurationBase::SuperscalarLatency * 3) + 2) * 32 +
+		// Main loop epilogue
+		((uint8_t*)randomx_calc_dataset_item_aarch64_x2_store_result - (uint8_t*)randomx_calc_dataset_item_aarch64_x2_mix) + 8
+	) +
+	// Epilogue
+	((uint8_t*)randomx_calc_dataset_item_aarch64_x2_end - (uint8_t*)randomx_calc_dataset_item_aarch64_x2_store_result);
+}
+
 constexpr uint32_t IntRegMap[8] = { 4, 5, 6, 7, 12, 13, 14, 15 };
 
-JitCompilerA64::JitCompilerA64(bool hugePagesEnable, bool) :
+// Dataset init with two interleaved items (same setting as AVX2 init on x86):
+// -1 = Auto detect (always enabled, every ARMv8 core benefits from the extra ILP)
+//  0 = Always disabled
+// +1 = Always enabled
+JitCompilerA64::JitCompilerA64(bool hugePagesEnable, bool optimizedInitDatasetEnable) :
 	hugePages(hugePagesJIT && hugePagesEnable),
+	initDatasetX2(optimizedInitDatasetEnable && (optimizedDatasetInit != 0)),
 	literalPos(ImulRcpLiteralsEnd)
 {
 }
@@ -241,7 +267,7 @@ template<size_t N>
 void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 {
 	if (!allocatedSize) {
-		allocate(CodeSize + CalcDatasetItemSize());
+		allocate(CodeSize + CalcDatasetItemSize() + (initDatasetX2 ? CalcDatasetItemX2Size() : 0));
 	}
 #ifdef XMRIG_SECURE_JIT
 	else {
@@ -359,6 +385,10 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 	memcpy(code + codePos, p1, p2 - p1);
 	codePos += p2 - p1;
 
+	if (initDatasetX2) {
+		generateSuperscalarHashX2(programs, codePos);
+	}
+
 #	ifndef XMRIG_OS_APPLE
 	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + CodeSize), codePos - MainLoopBegin);
 #	endif
@@ -366,12 +396,169 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 
 template void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[RANDOMX_CACHE_MAX_ACCESSES]);
 
+template<size_t N>
+void JitCompilerA64::generateSuperscalarHashX2(SuperscalarProgram(&programs)[N], uint32_t& codePos)
+{
+	// Second item uses x14-x17, x19-x22 (x18 is the platform register on Apple and Windows)
+	constexpr uint32_t RegMapX2[8] = { 14, 15, 16, 17, 19, 20, 21, 22 };
+	constexpr uint32_t tmp_reg = 12;
+
+	datasetInitX2Pos = codePos;
+
+	uint8_t* p1 = (uint8_t*)randomx_init_dataset_aarch64_x2;
+	uint8_t* p2 = (uint8_t*)randomx_init_dataset_aarch64_x2_end;
+	memcpy(code + codePos, p1, p2 - p1);
+	codePos += p2 - p1;
+
+	// bl randomx_calc_dataset_item_aarch64_x2
+	uint32_t k = datasetInitX2Pos + ((uint8_t*)randomx_init_dataset_aarch64_x2_main_loop - p1);
+	emit32(ARMV8A::BL | ((static_cast<int32_t>(codePos - k) / 4) & ((1 << 26) - 1)), code, k);
+
+	// bl randomx_calc_dataset_item_aarch64 (last item if their number is odd)
+	k = datasetInitX2Pos + ((uint8_t*)randomx_init_dataset_aarch64_x2_tail - p1);
+	emit32(ARMV8A::BL | ((static_cast<int32_t>(CodeSize - k) / 4) & ((1 << 26) - 1)), code, k);
+
+	p1 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2;
+	p2 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2_prefetch;
+	memcpy(code + codePos, p1, p2 - p1);
+	codePos += p2 - p1;
+
+	for (size_t i = 0; i < RandomX_ConfigurationBase::CacheAccesses; ++i)
+	{
+		// and x11, x10, CacheSize / CacheLineSize - 1
+		emit32(0x92400000 | 11 | (10 << 5) | ((RandomX_CurrentConfig.Log2_CacheSize - 1) << 10), code, codePos);
+
+		// and x24, x23, CacheSize / CacheLineSize - 1
+		emit32(0x92400000 | 24 | (23 << 5) | ((RandomX_CurrentConfig.Log2_CacheSize - 1) << 10), code, codePos);
+
+		p1 = ((uint8_t*)randomx_calc_dataset_item_aarch64_x2_prefetch) + 8;
+		p2 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2_mix;
+		memcpy(code + codePos, p1, p2 - p1);
+		codePos += p2 - p1;
+
+		SuperscalarProgram& prog = programs[i];
+		const size_t progSize = prog.getSize();
+
+		uint32_t jmp_pos = codePos;
+		codePos += 4;
+
+		// Fill in literal pool
+		for (size_t j = 0; j < progSize; ++j)
+		{
+			const Instruction& instr = prog(j);
+			if (static_cast<SuperscalarInstructionType>(instr.opcode) == randomx::SuperscalarInstructionType::IMUL_RCP)
+				emit64(randomx_reciprocal(instr.getImm32()), code, codePos);
+		}
+
+		// Jump over literal pool
+		uint32_t literal_pos = jmp_pos;
+		emit32(ARMV8A::B | ((codePos - jmp_pos) / 4), code, literal_pos);
+
+		// Every instruction is emitted for both items back to back, constants are loaded only once
+		for (size_t j = 0; j < progSize; ++j)
+		{
+			const Instruction& instr = prog(j);
+			const uint32_t src = instr.src;
+			const uint32_t dst = instr.dst;
+			const uint32_t src2 = RegMapX2[src];
+			const uint32_t dst2 = RegMapX2[dst];
+
+			switch (static_cast<SuperscalarInstructionType>(instr.opcode))
+			{
+			case randomx::SuperscalarInstructionType::ISUB_R:
+				emit32(ARMV8A::SUB | dst | (dst << 5) | (src << 16), code, codePos);
+				emit32(ARMV8A::SUB | dst2 | (dst2 << 5) | (src2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IXOR_R:
+				emit32(ARMV8A::EOR | dst | (dst << 5) | (src << 16), code, codePos);
+				emit32(ARMV8A::EOR | dst2 | (dst2 << 5) | (src2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IADD_RS:
+				emit32(ARMV8A::ADD | dst | (dst << 5) | (instr.getModShift() << 10) | (src << 16), code, codePos);
+				emit32(ARMV8A::ADD | dst2 | (dst2 << 5) | (instr.getModShift() << 10) | (src2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IMUL_R:
+				emit32(ARMV8A::MUL | dst | (dst << 5) | (src << 16), code, codePos);
+				emit32(ARMV8A::MUL | dst2 | (dst2 << 5) | (src2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IROR_C:
+				emit32(ARMV8A::ROR_IMM | dst | (dst << 5) | ((instr.getImm32() & 63) << 10) | (dst << 16), code, codePos);
+				emit32(ARMV8A::ROR_IMM | dst2 | (dst2 << 5) | ((instr.getImm32() & 63) << 10) | (dst2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IADD_C7:
+			case randomx::SuperscalarInstructionType::IADD_C8:
+			case randomx::SuperscalarInstructionType::IADD_C9:
+				if (instr.getImm32() < (1 << 24)) {
+					emitAddImmediate(dst, dst, instr.getImm32(), code, codePos);
+					emitAddImmediate(dst2, dst2, instr.getImm32(), code, codePos);
+				}
+				else {
+					// emitAddImmediate would use x20 as a temporary here, it holds the second item
+					emitMovImmediate(tmp_reg, instr.getImm32(), code, codePos);
+					emit32(ARMV8A::ADD | dst | (dst << 5) | (tmp_reg << 16), code, codePos);
+					emit32(ARMV8A::ADD | dst2 | (dst2 << 5) | (tmp_reg << 16), code, codePos);
+				}
+				break;
+			case randomx::SuperscalarInstructionType::IXOR_C7:
+			case randomx::SuperscalarInstructionType::IXOR_C8:
+			case randomx::SuperscalarInstructionType::IXOR_C9:
+				emitMovImmediate(tmp_reg, instr.getImm32(), code, codePos);
+				emit32(ARMV8A::EOR | dst | (dst << 5) | (tmp_reg << 16), code, codePos);
+				emit32(ARMV8A::EOR | dst2 | (dst2 << 5) | (tmp_reg << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IMULH_R:
+				emit32(ARMV8A::UMULH | dst | (dst << 5) | (src << 16), code, codePos);
+				emit32(ARMV8A::UMULH | dst2 | (dst2 << 5) | (src2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::ISMULH_R:
+				emit32(ARMV8A::SMULH | dst | (dst << 5) | (src << 16), code, codePos);
+				emit32(ARMV8A::SMULH | dst2 | (dst2 << 5) | (src2 << 16), code, codePos);
+				break;
+			case randomx::SuperscalarInstructionType::IMUL_RCP:
+				{
+					int32_t offset = (literal_pos - codePos) / 4;
+					offset &= (1 << 19) - 1;
+					literal_pos += 8;
+
+					// ldr tmp_reg, reciprocal
+					emit32(ARMV8A::LDR_LITERAL | tmp_reg | (offset << 5), code, codePos);
+
+					// mul dst, dst, tmp_reg
+					emit32(ARMV8A::MUL | dst | (dst << 5) | (tmp_reg << 16), code, codePos);
+					emit32(ARMV8A::MUL | dst2 | (dst2 << 5) | (tmp_reg << 16), code, codePos);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		p1 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2_mix;
+		p2 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2_store_result;
+		memcpy(code + codePos, p1, p2 - p1);
+		codePos += p2 - p1;
+
+		// Update registerValue
+		emit32(ARMV8A::MOV_REG | 10 | (prog.getAddressRegister() << 16), code, codePos);
+		emit32(ARMV8A::MOV_REG | 23 | (RegMapX2[prog.getAddressRegister()] << 16), code, codePos);
+	}
+
+	p1 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2_store_result;
+	p2 = (uint8_t*)randomx_calc_dataset_item_aarch64_x2_end;
+	memcpy(code + codePos, p1, p2 - p1);
+	codePos += p2 - p1;
+}
+
 DatasetInitFunc* JitCompilerA64::getDatasetInitFunc() const
 {
 #	ifdef XMRIG_SECURE_JIT
 	enableExecution();
 #	endif
 
+	if (datasetInitX2Pos) {
+		return (DatasetInitFunc*)(code + datasetInitX2Pos);
+	}
+
 	return (DatasetInitFunc*)(code + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
 }
 
@@ -78,6 +78,8 @@ namespace randomx {
 
 	private:
 		const bool hugePages;
+		const bool initDatasetX2;
+		uint32_t datasetInitX2Pos = 0;
 		uint32_t reg_changed_offset[8]{};
 		uint8_t* code = nullptr;
 		uint32_t literalPos;
@@ -86,6 +88,9 @@ namespace randomx {
 
 		void allocate(size_t size);
 
+		template<size_t N>
+		void generateSuperscalarHashX2(SuperscalarProgram(&programs)[N], uint32_t& codePos);
+
 		static void emit32(uint32_t val, uint8_t* code, uint32_t& codePos)
 		{
 			*(uint32_t*)(code + codePos) = val;
@@ -48,4 +48,13 @@ extern "C" {
 	void randomx_calc_dataset_item_aarch64_mix();
 	void randomx_calc_dataset_item_aarch64_store_result();
 	void randomx_calc_dataset_item_aarch64_end();
+	void randomx_init_dataset_aarch64_x2();
+	void randomx_init_dataset_aarch64_x2_main_loop();
+	void randomx_init_dataset_aarch64_x2_tail();
+	void randomx_init_dataset_aarch64_x2_end();
+	void randomx_calc_dataset_item_aarch64_x2();
+	void randomx_calc_dataset_item_aarch64_x2_prefetch();
+	void randomx_calc_dataset_item_aarch64_x2_mix();
+	void randomx_calc_dataset_item_aarch64_x2_store_result();
+	void randomx_calc_dataset_item_aarch64_x2_end();
 }
@@ -238,35 +238,20 @@ namespace randomx {
 				initDatasetAVX2 = true;
 			}
 			else if (optimizedDatasetInit < 0) {
-				xmrig::ICpuInfo::Vendor vendor = xmrig::Cpu::info()->vendor();
-				xmrig::ICpuInfo::Arch arch = xmrig::Cpu::info()->arch();
+				switch (xmrig::Cpu::info()->profile().datasetInit) {
+				case xmrig::CpuProfile::DATASET_INIT_AVX2:
+					initDatasetAVX2 = true;
+					break;
 
-				if (vendor == xmrig::ICpuInfo::VENDOR_INTEL) {
-					// AVX2 init is faster on Intel CPUs without HT
+				case xmrig::CpuProfile::DATASET_INIT_AVX2_NO_SMT:
+					// AVX2 init is faster only when it doesn't share a core with another thread
 					initDatasetAVX2 = (xmrig::Cpu::info()->cores() == xmrig::Cpu::info()->threads());
-				}
-				else if (vendor == xmrig::ICpuInfo::VENDOR_AMD) {
-					switch (arch) {
-					case xmrig::ICpuInfo::ARCH_ZEN:
-					case xmrig::ICpuInfo::ARCH_ZEN_PLUS:
-					default:
-						// AVX2 init is slower on Zen/Zen+
-						// Also disable it for other unknown architectures
-						initDatasetAVX2 = false;
-						break;
-					case xmrig::ICpuInfo::ARCH_ZEN2:
-						// AVX2 init is faster on Zen2 without SMT (mobile CPUs)
-						initDatasetAVX2 = (xmrig::Cpu::info()->cores() == xmrig::Cpu::info()->threads());
-						break;
-					case xmrig::ICpuInfo::ARCH_ZEN3:
-						// AVX2 init is faster on Zen3
-						initDatasetAVX2 = true;
-						break;
-					case xmrig::ICpuInfo::ARCH_ZEN4:
-						// AVX2 init is slower on Zen4
-						initDatasetAVX2 = false;
-						break;
-					}
+					break;
+
+				default:
+					// AVX2 init is slower, also disable it for unknown CPUs
+					initDatasetAVX2 = false;
+					break;
 				}
 			}
 		}
@@ -22,7 +22,9 @@
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
 #include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxHandover.h"
 #include "crypto/rx/RxQueue.h"
+#include "crypto/rx/RxTuner.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
 
@@ -55,6 +57,12 @@ public:
 } // namespace xmrig
 
 
+bool xmrig::Rx::handover()
+{
+    return d_ptr && d_ptr->queue.handover();
+}
+
+
 xmrig::HugePagesInfo xmrig::Rx::hugePages()
 {
     return d_ptr->queue.hugePages();
@@ -99,6 +107,11 @@ template<typename T>
 bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu)
 {
     const auto f = seed.algorithm().family();
+
+#   ifdef XMRIG_FEATURE_MSR
+    RxMsr::apply(config, f, cpu.threads().get(seed.algorithm()).data());
+#   endif
+
     if ((f != Algorithm::RANDOM_X)
 #       ifdef XMRIG_ALGO_CN_HEAVY
         && (f != Algorithm::CN_HEAVY)
@@ -107,19 +120,11 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         && (f != Algorithm::GHOSTRIDER)
 #       endif
         ) {
-#       ifdef XMRIG_FEATURE_MSR
-        RxMsr::destroy();
-#       endif
+        RxHandover::release();
 
         return true;
     }
 
-#   ifdef XMRIG_FEATURE_MSR
-    if (!RxMsr::isInitialized()) {
-        RxMsr::init(config, cpu.threads().get(seed.algorithm()).data());
-    }
-#   endif
-
 #   ifdef XMRIG_ALGO_CN_HEAVY
     if (f == Algorithm::CN_HEAVY) {
         return true;
@@ -132,9 +137,16 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     }
 #   endif
 
-    randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
-    randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+
+    if (!config.isAutotune() || !RxTuner::apply(seed.algorithm())) {
+        randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
+        randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+
+        if (config.isAutotune()) {
+            RxTuner::schedule(seed.algorithm(), cpu.threads().get(seed.algorithm()).data(), !cpu.isHwAES(), cpu.assembly(), cpu.isHugePages());
+        }
+    }
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
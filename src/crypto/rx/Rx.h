@@ -45,6 +45,7 @@ class RxDataset;
 class Rx
 {
 public:
+    static bool handover();
     static HugePagesInfo hugePages();
     static RxDataset *dataset(const Job &job, uint32_t nodeId);
     static void destroy();
@@ -83,7 +83,7 @@ public:
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        m_ready = m_dataset->init(m_seed, threads, priority);
 
         if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
@@ -143,6 +143,12 @@ bool xmrig::RxBasicStorage::isAllocated() const
 }
 
 
+bool xmrig::RxBasicStorage::upgradeHugePages()
+{
+    return d_ptr->dataset() && d_ptr->dataset()->upgradeHugePages();
+}
+
+
 xmrig::HugePagesInfo xmrig::RxBasicStorage::hugePages() const
 {
     if (!d_ptr->dataset()) {
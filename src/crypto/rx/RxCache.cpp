@@ -79,6 +79,19 @@ xmrig::HugePagesInfo xmrig::RxCache::hugePages() const
 }
 
 
+size_t xmrig::RxCache::release()
+{
+    const size_t size = m_memory ? m_memory->discard() : 0;
+
+    // Content is lost, the next init() must rebuild the cache even for the same seed.
+    if (size) {
+        m_seed.clear();
+    }
+
+    return size;
+}
+
+
 void xmrig::RxCache::create(uint8_t *memory)
 {
     if (!memory) {
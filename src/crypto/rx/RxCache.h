@@ -60,6 +60,7 @@ public:
 
     bool init(const Buffer &seed);
     HugePagesInfo hugePages() const;
+    size_t release();
 
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
 
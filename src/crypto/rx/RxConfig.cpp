@@ -19,12 +19,14 @@
 #include "crypto/rx/RxConfig.h"
 #include "3rdparty/rapidjson/document.h"
 #include "backend/cpu/Cpu.h"
+#include "base/crypto/Algorithm.h"
 #include "base/io/json/Json.h"
 
 
 #include <array>
 #include <algorithm>
 #include <cmath>
+#include <string>
 
 
 #ifdef _MSC_VER
@@ -38,11 +40,13 @@ const char *RxConfig::kInit                     = "init";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
 const char *RxConfig::kField                    = "randomx";
 const char *RxConfig::kMode                     = "mode";
+const char *RxConfig::kMsrProfiles              = "msr_profiles";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kAutotune                 = "autotune";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -53,19 +57,31 @@ static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "
 
 
 #ifdef XMRIG_FEATURE_MSR
-constexpr size_t kMsrArraySize = 6;
+constexpr size_t kMsrArraySize = 7;
 
 static const std::array<MsrItems, kMsrArraySize> msrPresets = {
     MsrItems(),
     MsrItems{{ 0xC0011020, 0ULL }, { 0xC0011021, 0x40ULL, ~0x20ULL }, { 0xC0011022, 0x1510000ULL }, { 0xC001102b, 0x2000cc16ULL }},
     MsrItems{{ 0xC0011020, 0x0004480000000000ULL }, { 0xC0011021, 0x001c000200000040ULL, ~0x20ULL }, { 0xC0011022, 0xc000000401570000ULL }, { 0xC001102b, 0x2000cc10ULL }},
     MsrItems{{ 0xC0011020, 0x0004400000000000ULL }, { 0xC0011021, 0x0004000000000040ULL, ~0x20ULL }, { 0xC0011022, 0x8680000401570000ULL }, { 0xC001102b, 0x2040cc10ULL }},
+    MsrItems{{ 0xC0011020, 0x0004400000000000ULL }, { 0xC0011021, 0x0004000000000040ULL, ~0x20ULL }, { 0xC0011022, 0x8680000401570000ULL }, { 0xC001102b, 0x2040cc10ULL }},
     MsrItems{{ 0x1a4, 0xf }},
     MsrItems()
 };
 
 static const std::array<const char *, kMsrArraySize> modNames = { MSR_NAMES_LIST };
 
+static const std::map<std::string, uint32_t> msrFamilies = {
+    { "rx",         Algorithm::RANDOM_X },
+    { "cn",         Algorithm::CN },
+    { "cn-lite",    Algorithm::CN_LITE },
+    { "cn-heavy",   Algorithm::CN_HEAVY },
+    { "cn-pico",    Algorithm::CN_PICO },
+    { "cn-femto",   Algorithm::CN_FEMTO },
+    { "argon2",     Algorithm::ARGON2 },
+    { "ghostrider", Algorithm::GHOSTRIDER }
+};
+
 static_assert (kMsrArraySize == ICpuInfo::MSR_MOD_MAX, "kMsrArraySize and MSR_MOD_MAX mismatch");
 #endif
 
@@ -82,10 +98,12 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         m_rdmsr           = Json::getBool(value, kRdmsr, m_rdmsr);
 
 #       ifdef XMRIG_FEATURE_MSR
-        readMSR(Json::getValue(value, kWrmsr));
+        m_wrmsr = readMSR(Json::getValue(value, kWrmsr), m_msrPreset, m_wrmsr);
+        readMsrProfiles(Json::getValue(value, kMsrProfiles));
 #       endif
 
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_autotune = Json::getBool(value, kAutotune, m_autotune);
 
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
@@ -151,6 +169,30 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
     else {
         obj.AddMember(StringRef(kWrmsr), m_wrmsr, allocator);
     }
+
+    if (!m_msrProfiles.empty()) {
+        Value profiles(kObjectType);
+
+        for (const auto &family : msrFamilies) {
+            const auto it = m_msrProfiles.find(family.second);
+            if (it == m_msrProfiles.end()) {
+                continue;
+            }
+
+            Value profile(it->second.enabled && it->second.items.empty());
+            if (!it->second.items.empty()) {
+                profile.SetArray();
+
+                for (const auto &i : it->second.items) {
+                    profile.PushBack(i.toJSON(doc), allocator);
+                }
+            }
+
+            profiles.AddMember(StringRef(family.first.c_str()), profile, allocator);
+        }
+
+        obj.AddMember(StringRef(kMsrProfiles), profiles, allocator);
+    }
 #   else
     obj.AddMember(StringRef(kWrmsr), false, allocator);
 #   endif
@@ -173,6 +215,7 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kScratchpadPrefetchMode), static_cast<int>(m_scratchpadPrefetchMode), allocator);
+    obj.AddMember(StringRef(kAutotune),     m_autotune, allocator);
 
     return obj;
 }
@@ -217,6 +260,21 @@ const char *xmrig::RxConfig::msrPresetName() const
 }
 
 
+const char *xmrig::RxConfig::msrPresetName(uint32_t family) const
+{
+    const auto it = m_msrProfiles.find(family);
+    if (it == m_msrProfiles.end() || !wrmsr()) {
+        return msrPreset(family).empty() ? modNames[ICpuInfo::MSR_MOD_NONE] : msrPresetName();
+    }
+
+    if (!it->second.enabled) {
+        return modNames[ICpuInfo::MSR_MOD_NONE];
+    }
+
+    return it->second.items.empty() ? msrPresetName() : modNames[ICpuInfo::MSR_MOD_CUSTOM];
+}
+
+
 const xmrig::MsrItems &xmrig::RxConfig::msrPreset() const
 {
     const auto mod = msrMod();
@@ -229,6 +287,26 @@ const xmrig::MsrItems &xmrig::RxConfig::msrPreset() const
 }
 
 
+const xmrig::MsrItems &xmrig::RxConfig::msrPreset(uint32_t family) const
+{
+    const auto it = m_msrProfiles.find(family);
+    if (it != m_msrProfiles.end() && wrmsr()) {
+        if (!it->second.enabled) {
+            return msrPresets[ICpuInfo::MSR_MOD_NONE];
+        }
+
+        return it->second.items.empty() ? msrPreset() : it->second.items;
+    }
+
+    // cn-heavy and GhostRider benefit from the RandomX preset, other algorithms run with the original register values.
+    if (family == Algorithm::RANDOM_X || family == Algorithm::CN_HEAVY || family == Algorithm::GHOSTRIDER) {
+        return msrPreset();
+    }
+
+    return msrPresets[ICpuInfo::MSR_MOD_NONE];
+}
+
+
 uint32_t xmrig::RxConfig::msrMod() const
 {
     if (!wrmsr()) {
@@ -243,23 +321,20 @@ uint32_t xmrig::RxConfig::msrMod() const
 }
 
 
-void xmrig::RxConfig::readMSR(const rapidjson::Value &value)
+bool xmrig::RxConfig::readMSR(const rapidjson::Value &value, MsrItems &items, bool enabled)
 {
     if (value.IsBool()) {
-        m_wrmsr = value.GetBool();
-
-        return;
+        return value.GetBool();
     }
 
     if (value.IsInt()) {
         const int i = std::min(value.GetInt(), 15);
-        if (i >= 0) {
-            if (Cpu::info()->vendor() == ICpuInfo::VENDOR_INTEL) {
-                m_msrPreset.emplace_back(0x1a4, i);
-            }
+        if (i < 0) {
+            return false;
         }
-        else {
-            m_wrmsr = false;
+
+        if (Cpu::info()->vendor() == ICpuInfo::VENDOR_INTEL) {
+            items.emplace_back(0x1a4, i);
         }
     }
 
@@ -267,11 +342,33 @@ void xmrig::RxConfig::readMSR(const rapidjson::Value &value)
         for (const auto &i : value.GetArray()) {
             MsrItem item(i);
             if (item.isValid()) {
-                m_msrPreset.emplace_back(item);
+                items.emplace_back(item);
             }
         }
 
-        m_wrmsr = !m_msrPreset.empty();
+        return !items.empty();
+    }
+
+    return enabled;
+}
+
+
+void xmrig::RxConfig::readMsrProfiles(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    for (const auto &member : value.GetObject()) {
+        const auto family = msrFamilies.find(member.name.GetString());
+        if (family == msrFamilies.end() || (!member.value.IsBool() && !member.value.IsInt() && !member.value.IsArray())) {
+            continue;
+        }
+
+        MsrProfile profile;
+        profile.enabled = readMSR(member.value, profile.items, true);
+
+        m_msrProfiles[family->second] = std::move(profile);
     }
 }
 #endif
@@ -28,6 +28,7 @@
 #endif
 
 
+#include <map>
 #include <vector>
 
 
@@ -52,11 +53,13 @@ public:
         ScratchpadPrefetchMax,
     };
 
+    static const char *kAutotune;
     static const char *kCacheQoS;
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
     static const char *kMode;
+    static const char *kMsrProfiles;
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
@@ -78,6 +81,7 @@ public:
     const char *modeName() const;
     uint32_t threads(uint32_t limit = 100) const;
 
+    inline bool isAutotune() const      { return m_autotune; }
     inline int initDatasetAVX2() const  { return m_initDatasetAVX2; }
     inline bool isOneGbPages() const    { return m_oneGbPages; }
     inline bool rdmsr() const           { return m_rdmsr; }
@@ -89,20 +93,32 @@ public:
 
 #   ifdef XMRIG_FEATURE_MSR
     const char *msrPresetName() const;
+    const char *msrPresetName(uint32_t family) const;
     const MsrItems &msrPreset() const;
+    const MsrItems &msrPreset(uint32_t family) const;
 #   endif
 
 private:
 #   ifdef XMRIG_FEATURE_MSR
+    struct MsrProfile
+    {
+        bool enabled = true;
+        MsrItems items;
+    };
+
+    static bool readMSR(const rapidjson::Value &value, MsrItems &items, bool enabled);
+
     uint32_t msrMod() const;
-    void readMSR(const rapidjson::Value &value);
+    void readMsrProfiles(const rapidjson::Value &value);
 
     bool m_wrmsr = true;
     MsrItems m_msrPreset;
+    std::map<uint32_t, MsrProfile> m_msrProfiles;
 #   else
     bool m_wrmsr = false;
 #   endif
 
+    bool m_autotune = false;
     bool m_cacheQoS = false;
 
     static Mode readMode(const rapidjson::Value &value);
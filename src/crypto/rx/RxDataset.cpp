@@ -26,6 +26,8 @@
 #include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxHandover.h"
+#include "crypto/rx/RxSeed.h"
 
 
 #include <thread>
@@ -35,6 +37,9 @@
 namespace xmrig {
 
 
+constexpr size_t oneMiB = 1024 * 1024;
+
+
 static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, int priority)
 {
     Platform::setThreadPriority(priority);
@@ -49,6 +54,36 @@ static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache,
 }
 
 
+// In fast mode the cache is only needed to build the dataset, it is rebuilt from scratch on the next seed anyway.
+static void releaseCache(RxCache *cache)
+{
+    size_t before = 0;
+    uv_resident_set_memory(&before);
+
+    const size_t pages = cache->hugePages().allocated;
+    const size_t size  = cache->release();
+    if (!size) {
+        return;
+    }
+
+    size_t after = 0;
+    uv_resident_set_memory(&after);
+
+    if (after >= before) {
+        return;
+    }
+
+    LOG_INFO("%s" GREEN_BOLD("cache released") CYAN_BOLD(" %zu MB") BLACK_BOLD(" (RSS %zu -> %zu MB, huge pages %zu -> %zu)"),
+             Tags::randomx(),
+             size / oneMiB,
+             before / oneMiB,
+             after / oneMiB,
+             pages,
+             cache->hugePages().allocated
+             );
+}
+
+
 } // namespace xmrig
 
 
@@ -86,13 +121,19 @@ xmrig::RxDataset::~RxDataset()
 }
 
 
-bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priority)
+bool xmrig::RxDataset::init(const RxSeed &seed, uint32_t numThreads, int priority)
 {
     if (!m_cache || !m_cache->get()) {
         return false;
     }
 
-    m_cache->init(seed);
+    if (get() && RxHandover::restore(seed, raw(), maxSize())) {
+        releaseCache(m_cache);
+
+        return true;
+    }
+
+    m_cache->init(seed.data());
 
     if (!get()) {
         return true;
@@ -118,6 +159,8 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
         init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority);
     }
 
+    releaseCache(m_cache);
+
     return true;
 }
 
@@ -162,6 +205,12 @@ size_t xmrig::RxDataset::size(bool cache) const
 }
 
 
+bool xmrig::RxDataset::upgradeHugePages()
+{
+    return m_memory && m_memory->upgradeHugePages();
+}
+
+
 uint8_t *xmrig::RxDataset::tryAllocateScrathpad()
 {
     auto p = reinterpret_cast<uint8_t *>(raw());
@@ -0,0 +1,169 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxHandover.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#ifdef XMRIG_OS_LINUX
+#   include <algorithm>
+#   include <cerrno>
+#   include <cstdlib>
+#   include <cstring>
+#   include <fcntl.h>
+#   include <linux/falloc.h>
+#   include <string>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+
+namespace xmrig {
+
+
+#ifdef XMRIG_OS_LINUX
+static const char *kEnv     = "XMRIG_RX_HANDOVER";
+constexpr size_t kChunkSize = 64 * 1024 * 1024;
+
+
+static int handoverFd()
+{
+    const char *value = getenv(kEnv);
+
+    return value ? static_cast<int>(strtol(value, nullptr, 10)) : -1;
+}
+
+
+static std::string handoverId(int fd, const RxSeed &seed)
+{
+    return std::to_string(fd) + ":" + seed.algorithm().name() + ":" + Cvt::toHex(seed.data().data(), seed.data().size()).data();
+}
+#endif
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxHandover::restore(const RxSeed &seed, void *dst, size_t size)
+{
+#   ifdef XMRIG_OS_LINUX
+    const int fd = handoverFd();
+    if (fd < 0) {
+        return false;
+    }
+
+    const uint64_t ts = Chrono::steadyMSecs();
+    struct stat st{};
+
+    if (handoverId(fd, seed) != getenv(kEnv) || fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != size) {
+        release();
+
+        return false;
+    }
+
+    // Every chunk is dropped from the memory file right after it is copied, so both copies never exist in full at the same time.
+    auto out = static_cast<uint8_t *>(dst);
+    size_t offset = 0;
+
+    while (offset < size) {
+        const ssize_t n = pread(fd, out + offset, std::min(kChunkSize, size - offset), static_cast<off_t>(offset));
+        if (n <= 0) {
+            break;
+        }
+
+        fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), n);
+        offset += static_cast<size_t>(n);
+    }
+
+    release();
+
+    if (offset != size) {
+        return false;
+    }
+
+    LOG_INFO("%s" GREEN_BOLD("dataset restored from previous process") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
+bool xmrig::RxHandover::save(const RxSeed &seed, void *src, size_t size)
+{
+#   ifdef XMRIG_OS_LINUX
+    release();
+
+    // No MFD_CLOEXEC: the descriptor must survive execv().
+    const int fd = memfd_create("xmrig-rx-dataset", 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Source pages are released as soon as they are written, so the process doesn't need memory for two datasets.
+    auto in = static_cast<uint8_t *>(src);
+    size_t offset = 0;
+
+    while (offset < size) {
+        const ssize_t n = write(fd, in + offset, std::min(kChunkSize, size - offset));
+        if (n <= 0) {
+            break;
+        }
+
+        // The dataset size is not a multiple of the chunk size, the final partial chunk is released as well.
+        if (n == static_cast<ssize_t>(kChunkSize) || offset + static_cast<size_t>(n) == size) {
+            madvise(in + offset, static_cast<size_t>(n), MADV_DONTNEED);
+        }
+
+        offset += static_cast<size_t>(n);
+    }
+
+    if (offset != size) {
+        LOG_ERR("%s" RED("failed to save dataset for the new process: \"%s\""), Tags::randomx(), strerror(errno));
+        close(fd);
+
+        return false;
+    }
+
+    setenv(kEnv, handoverId(fd, seed).c_str(), 1);
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
+void xmrig::RxHandover::release()
+{
+#   ifdef XMRIG_OS_LINUX
+    const int fd = handoverFd();
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    unsetenv(kEnv);
+#   endif
+}
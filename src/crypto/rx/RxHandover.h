@@ -0,0 +1,52 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_RX_HANDOVER_H
+#define XMRIG_RX_HANDOVER_H
+
+
+#include <cstddef>
+
+
+namespace xmrig
+{
+
+
+class RxSeed;
+
+
+/**
+ * Passes a ready RandomX dataset to a new process image across execv(): the dataset is copied into
+ * an anonymous memory file which is inherited by the new image, its descriptor, algorithm and seed are
+ * stored in the environment. save() releases the source memory while copying, the dataset is not usable after it.
+ * Linux only, on other systems all functions do nothing.
+ */
+class RxHandover
+{
+public:
+    static bool restore(const RxSeed &seed, void *dst, size_t size);
+    static bool save(const RxSeed &seed, void *src, size_t size);
+    static void release();
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_HANDOVER_H */
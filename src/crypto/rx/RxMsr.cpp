@@ -21,6 +21,7 @@
 #include "crypto/rx/RxMsr.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuThread.h"
+#include "base/crypto/Algorithm.h"
 #include "base/io/log/Log.h"
 #include "base/tools/Chrono.h"
 #include "crypto/rx/RxConfig.h"
@@ -37,9 +38,11 @@ namespace xmrig {
 bool RxMsr::m_cacheQoS      = false;
 bool RxMsr::m_enabled       = false;
 bool RxMsr::m_initialized   = false;
+uint32_t RxMsr::m_family    = 0;
 
 
-static MsrItems items;
+static MsrItems items;      // Original values of all registers changed so far.
+static MsrItems applied;    // Preset currently written to the registers.
 
 
 #ifdef XMRIG_OS_WIN
@@ -49,30 +52,71 @@ static constexpr inline int32_t get_cpu(int32_t cpu)    { return cpu; }
 #endif
 
 
-static bool wrmsr(const MsrItems &preset, const std::vector<CpuThread> &threads, bool cache_qos, bool save)
+static const MsrItem *original(uint32_t reg)
 {
-    auto msr = Msr::get();
-    if (!msr) {
-        return false;
+    const auto it = std::find_if(items.begin(), items.end(), [reg](const MsrItem &item) { return item.reg() == reg; });
+
+    return it != items.end() ? &*it : nullptr;
+}
+
+
+static bool contains(const MsrItems &preset, uint32_t reg)
+{
+    return std::any_of(preset.begin(), preset.end(), [reg](const MsrItem &item) { return item.reg() == reg; });
+}
+
+
+static bool save(const std::shared_ptr<Msr> &msr, const MsrItems &preset)
+{
+    for (const auto &i : preset) {
+        if (original(i.reg())) {
+            continue;
+        }
+
+        auto item = msr->read(i.reg());
+        if (!item.isValid()) {
+            return false;
+        }
+
+        LOG_VERBOSE("%s " CYAN_BOLD("0x%08" PRIx32) CYAN(":0x%016" PRIx64) CYAN_BOLD(" -> 0x%016" PRIx64), Msr::tag(), i.reg(), item.value(), MsrItem::maskedValue(item.value(), i.value(), i.mask()));
+
+        items.emplace_back(item);
     }
 
-    if (save) {
-        items.reserve(preset.size());
+    return true;
+}
 
-        for (const auto &i : preset) {
-            auto item = msr->read(i.reg());
-            if (!item.isValid()) {
-                items.clear();
 
-                return false;
-            }
+// Registers to write to every core to move from the applied preset to the new one, one batch per core.
+static MsrItems transition(const MsrItems &preset)
+{
+    MsrItems out;
+    out.reserve(applied.size() + preset.size());
 
-            LOG_VERBOSE("%s " CYAN_BOLD("0x%08" PRIx32) CYAN(":0x%016" PRIx64) CYAN_BOLD(" -> 0x%016" PRIx64), Msr::tag(), i.reg(), item.value(), MsrItem::maskedValue(item.value(), i.value(), i.mask()));
+    for (const auto &i : applied) {
+        const auto item = original(i.reg());
+        if (item && !contains(preset, i.reg())) {
+            out.emplace_back(*item);
+        }
+    }
 
-            items.emplace_back(item);
+    for (const auto &i : preset) {
+        // Masked values are based on the original value, not on what the applied preset left in the register.
+        const auto item = contains(applied, i.reg()) ? original(i.reg()) : nullptr;
+        if (item && i.mask() != MsrItem::kNoMask) {
+            out.emplace_back(i.reg(), MsrItem::maskedValue(item->value(), i.value(), i.mask()));
+        }
+        else {
+            out.emplace_back(i);
         }
     }
 
+    return out;
+}
+
+
+static bool wrmsr(const std::shared_ptr<Msr> &msr, const MsrItems &preset, const std::vector<CpuThread> &threads, bool cache_qos)
+{
     // Which CPU cores will have access to the full L3 cache
     std::set<int32_t> cacheEnabled;
     bool cacheQoSDisabled = threads.empty();
@@ -96,10 +140,8 @@ static bool wrmsr(const MsrItems &preset, const std::vector<CpuThread> &threads,
     }
 
     return msr->write([&msr, &preset, cache_qos, &cacheEnabled, cacheQoSDisabled](int32_t cpu) {
-        for (const auto &item : preset) {
-            if (!msr->write(item, get_cpu(cpu))) {
-                return false;
-            }
+        if (!preset.empty() && !msr->write(preset, get_cpu(cpu))) {
+            return false;
         }
 
         if (!cache_qos) {
@@ -128,31 +170,54 @@ static bool wrmsr(const MsrItems &preset, const std::vector<CpuThread> &threads,
 } // namespace xmrig
 
 
-bool xmrig::RxMsr::init(const RxConfig &config, const std::vector<CpuThread> &threads)
+bool xmrig::RxMsr::apply(const RxConfig &config, uint32_t family, const std::vector<CpuThread> &threads)
 {
-    if (isInitialized()) {
+    if (isInitialized() && family == m_family) {
         return isEnabled();
     }
 
+    const auto &preset = config.msrPreset(family);
+    bool cacheQoS      = family == Algorithm::RANDOM_X && config.cacheQoS() && !preset.empty();
+    const bool changed = preset != applied || cacheQoS != m_cacheQoS;
+
     m_initialized = true;
-    m_enabled     = false;
+    m_family      = family;
 
-    const auto &preset = config.msrPreset();
-    if (preset.empty()) {
-        return false;
-    }
+    if (!changed || (preset.empty() && items.empty() && !m_cacheQoS)) {
+        applied   = preset;
+        m_enabled = m_enabled && !preset.empty();
 
-    const uint64_t ts = Chrono::steadyMSecs();
-    m_cacheQoS        = config.cacheQoS();
+        return isEnabled();
+    }
 
-    if (m_cacheQoS && !Cpu::info()->hasCatL3()) {
+    if (cacheQoS && !Cpu::info()->hasCatL3()) {
         LOG_WARN("%s " YELLOW_BOLD("this CPU doesn't support cat_l3, cache QoS is unavailable"), Msr::tag());
 
-        m_cacheQoS = false;
+        cacheQoS = false;
     }
 
-    if ((m_enabled = wrmsr(preset, threads, m_cacheQoS, config.rdmsr()))) {
-        LOG_NOTICE("%s " GREEN_BOLD("register values for \"%s\" preset have been set successfully") BLACK_BOLD(" (%" PRIu64 " ms)"), Msr::tag(), config.msrPresetName(), Chrono::steadyMSecs() - ts);
+    const uint64_t ts = Chrono::steadyMSecs();
+    auto msr          = Msr::get();
+    bool success      = msr && (!config.rdmsr() || save(msr, preset));
+
+    if (success) {
+        success = wrmsr(msr, transition(preset), cacheQoS ? threads : std::vector<CpuThread>(), cacheQoS || m_cacheQoS);
+    }
+
+    applied    = preset;
+    m_cacheQoS = cacheQoS;
+    m_enabled  = success && !preset.empty();
+
+    if (preset.empty()) {
+        if (success) {
+            LOG_VERBOSE("%s " GREEN_BOLD("initial register values have been restored") BLACK_BOLD(" (%" PRIu64 " ms)"), Msr::tag(), Chrono::steadyMSecs() - ts);
+        }
+        else {
+            LOG_ERR("%s " RED_BOLD("failed to restore initial state" BLACK_BOLD(" (%" PRIu64 " ms)")), Msr::tag(), Chrono::steadyMSecs() - ts);
+        }
+    }
+    else if (success) {
+        LOG_NOTICE("%s " GREEN_BOLD("register values for \"%s\" preset have been set successfully") BLACK_BOLD(" (%" PRIu64 " ms)"), Msr::tag(), config.msrPresetName(family), Chrono::steadyMSecs() - ts);
     }
     else {
         LOG_ERR("%s " RED_BOLD("FAILED TO APPLY MSR MOD, HASHRATE WILL BE LOW"), Msr::tag());
@@ -170,14 +235,21 @@ void xmrig::RxMsr::destroy()
 
     m_initialized = false;
     m_enabled     = false;
+    m_family      = 0;
 
     if (items.empty()) {
+        applied.clear();
+
         return;
     }
 
     const uint64_t ts = Chrono::steadyMSecs();
+    auto msr          = Msr::get();
 
-    if (!wrmsr(items, std::vector<CpuThread>(), m_cacheQoS, false)) {
+    if (!msr || !wrmsr(msr, transition(MsrItems()), std::vector<CpuThread>(), m_cacheQoS)) {
         LOG_ERR("%s " RED_BOLD("failed to restore initial state" BLACK_BOLD(" (%" PRIu64 " ms)")), Msr::tag(), Chrono::steadyMSecs() - ts);
     }
+
+    applied.clear();
+    m_cacheQoS = false;
 }
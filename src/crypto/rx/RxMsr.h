@@ -21,6 +21,7 @@
 #define XMRIG_RXMSR_H
 
 
+#include <cstdint>
 #include <vector>
 
 
@@ -38,13 +39,14 @@ public:
     static inline bool isEnabled()      { return m_enabled; }
     static inline bool isInitialized()  { return m_initialized; }
 
-    static bool init(const RxConfig &config, const std::vector<CpuThread> &threads);
+    static bool apply(const RxConfig &config, uint32_t family, const std::vector<CpuThread> &threads);
     static void destroy();
 
 private:
     static bool m_cacheQoS;
     static bool m_enabled;
     static bool m_initialized;
+    static uint32_t m_family;
 };
 
 
@@ -19,6 +19,7 @@
 
 #include "crypto/rx/RxNUMAStorage.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/platform/MemoryTiers.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
@@ -42,15 +43,16 @@ constexpr size_t oneMiB = 1024 * 1024;
 static std::mutex mutex;
 
 
-static bool bindToNUMANode(uint32_t nodeId)
+static bool bindToNUMANode(uint32_t nodeId, uint32_t cpuNodeId)
 {
-    auto node = hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), nodeId);
-    if (!node) {
+    auto node    = hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), nodeId);
+    auto cpuNode = hwloc_get_numanode_obj_by_os_index(Cpu::info()->topology(), cpuNodeId);
+    if (!node || !cpuNode) {
         return false;
     }
 
     if (Cpu::info()->membind(node->nodeset)) {
-        Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
+        Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(cpuNode->cpuset)));
 
         return true;
     }
@@ -80,6 +82,25 @@ public:
         m_nodeset(nodeset)
     {
         m_threads.reserve(nodeset.size());
+
+        // CPU-less nodes (HBM in flat mode, CXL, PMEM) only hold data for the CPUs of other nodes.
+        for (uint32_t node : nodeset) {
+            if (MemoryTiers::hasCpus(node)) {
+                m_placement.insert({ node, MemoryTiers::fast(node, RxDataset::maxSize()) });
+            }
+        }
+
+        if (m_placement.empty()) {
+            for (uint32_t node : nodeset) {
+                m_placement.insert({ node, node });
+            }
+        }
+
+#       ifdef XMRIG_HWLOC_DEBUG
+        for (const auto &kv : m_placement) {
+            LOG_INFO("%s" CYAN_BOLD("#%u") " dataset on " CYAN_BOLD("#%u ") WHITE_BOLD("%s"), Tags::randomx(), kv.first, kv.second, MemoryTiers::tier(kv.second));
+        }
+#       endif
     }
 
 
@@ -94,7 +115,8 @@ public:
 
     inline bool isAllocated() const                     { return m_allocated; }
     inline bool isReady(const Job &job) const           { return m_ready && m_seed == job; }
-    inline RxDataset *dataset(uint32_t nodeId) const    { return m_datasets.count(nodeId) ? m_datasets.at(nodeId) : m_datasets.at(m_nodeset.front()); }
+    inline RxDataset *dataset(uint32_t nodeId) const    { return m_datasets.count(memoryNode(nodeId)) ? m_datasets.at(memoryNode(nodeId)) : m_datasets.at(memoryNode(m_nodeset.front())); }
+    inline uint32_t memoryNode(uint32_t nodeId) const   { return m_placement.count(nodeId) ? m_placement.at(nodeId) : nodeId; }
 
 
     inline void setSeed(const RxSeed &seed)
@@ -113,14 +135,19 @@ public:
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        for (uint32_t node : m_nodeset) {
-            m_threads.emplace_back(allocate, this, node, hugePages, oneGbPages);
+        std::map<uint32_t, uint32_t> nodes;
+        for (const auto &kv : m_placement) {
+            nodes.insert({ kv.second, kv.first });
+        }
+
+        for (const auto &kv : nodes) {
+            m_threads.emplace_back(allocate, this, kv.first, kv.second, hugePages, oneGbPages);
         }
 
         join();
 
         if (isCacheRequired()) {
-            std::thread thread(allocateCache, this, m_nodeset.front(), hugePages);
+            std::thread thread(allocateCache, this, memoryNode(m_nodeset.front()), m_nodeset.front(), hugePages);
             thread.join();
 
             if (!m_cache) {
@@ -129,7 +156,7 @@ public:
         }
 
         if (m_datasets.empty()) {
-            m_datasets.insert({ m_nodeset.front(), new RxDataset(m_cache) });
+            m_datasets.insert({ memoryNode(m_nodeset.front()), new RxDataset(m_cache) });
 
             LOG_WARN(CLEAR "%s" YELLOW_BOLD_S "failed to allocate RandomX datasets, switching to slow mode" BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
         }
@@ -174,8 +201,8 @@ public:
             }
         }
 
-        auto primary = dataset(id);
-        primary->init(m_seed.data(), threads, priority);
+        auto primary = m_datasets.at(id);
+        primary->init(m_seed, threads, priority);
 
         printDatasetReady(id, ts);
 
@@ -195,6 +222,17 @@ public:
     }
 
 
+    inline bool upgradeHugePages()
+    {
+        bool changed = false;
+        for (auto const &item : m_datasets) {
+            changed |= item.second->upgradeHugePages();
+        }
+
+        return changed;
+    }
+
+
     inline HugePagesInfo hugePages() const
     {
         HugePagesInfo pages;
@@ -207,11 +245,11 @@ public:
 
 
 private:
-    static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool oneGbPages)
+    static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, uint32_t cpuNodeId, bool hugePages, bool oneGbPages)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        if (!bindToNUMANode(nodeId)) {
+        if (!bindToNUMANode(nodeId, cpuNodeId)) {
             printSkipped(nodeId, "can't bind memory");
 
             return;
@@ -227,15 +265,15 @@ private:
 
         std::lock_guard<std::mutex> lock(mutex);
         d_ptr->m_datasets.insert({ nodeId, dataset });
-        RxNUMAStoragePrivate::printAllocStatus(dataset, nodeId, ts);
+        RxNUMAStoragePrivate::printAllocStatus(dataset, nodeId, cpuNodeId, ts);
     }
 
 
-    static void allocateCache(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages)
+    static void allocateCache(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, uint32_t cpuNodeId, bool hugePages)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        bindToNUMANode(nodeId);
+        bindToNUMANode(nodeId, cpuNodeId);
 
         auto cache = new RxCache(hugePages, nodeId);
         if (!cache->get()) {
@@ -262,16 +300,18 @@ private:
     }
 
 
-    static void printAllocStatus(RxDataset *dataset, uint32_t nodeId, uint64_t ts)
+    static void printAllocStatus(RxDataset *dataset, uint32_t nodeId, uint32_t cpuNodeId, uint64_t ts)
     {
         const auto pages = dataset->hugePages();
 
-        LOG_INFO("%s" CYAN_BOLD("#%u ") GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") " huge pages %s%3.0f%%" CLEAR BLACK_BOLD(" (%" PRIu64 " ms)"),
+        LOG_INFO("%s" CYAN_BOLD("#%u ") GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") " huge pages %s%3.0f%%" CLEAR "%s%s" BLACK_BOLD(" (%" PRIu64 " ms)"),
                  Tags::randomx(),
                  nodeId,
                  pages.size / oneMiB,
                  (pages.isFullyAllocated() ? GREEN_BOLD_S : RED_BOLD_S),
                  pages.percent(),
+                 nodeId == cpuNodeId ? "" : " ",
+                 nodeId == cpuNodeId ? "" : MemoryTiers::tier(nodeId),
                  Chrono::steadyMSecs() - ts
                  );
     }
@@ -324,6 +364,7 @@ private:
     RxCache *m_cache        = nullptr;
     RxSeed m_seed;
     std::map<uint32_t, RxDataset *> m_datasets;
+    std::map<uint32_t, uint32_t> m_placement;   // CPU node -> memory node with its dataset
     std::vector<std::thread> m_threads;
     std::vector<uint32_t> m_nodeset;
 };
@@ -350,6 +391,12 @@ bool xmrig::RxNUMAStorage::isAllocated() const
 }
 
 
+bool xmrig::RxNUMAStorage::upgradeHugePages()
+{
+    return d_ptr->isAllocated() && d_ptr->upgradeHugePages();
+}
+
+
 xmrig::HugePagesInfo xmrig::RxNUMAStorage::hugePages() const
 {
     if (!d_ptr->isAllocated()) {
@@ -25,6 +25,9 @@
 #include "base/io/log/Tags.h"
 #include "base/tools/Cvt.h"
 #include "crypto/rx/RxBasicStorage.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxHandover.h"
+#include "crypto/rx/RxTuner.h"
 
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -74,6 +77,23 @@ xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 }
 
 
+bool xmrig::RxQueue::handover()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_storage || m_state != STATE_IDLE) {
+        return false;
+    }
+
+    Job job(false, m_seed.algorithm(), String());
+    job.setSeedHash(m_seed.data().data(), m_seed.data().size());
+
+    RxDataset *dataset = m_storage->dataset(job, 0);
+
+    return dataset && dataset->raw() && RxHandover::save(m_seed, dataset->raw(), RxDataset::maxSize());
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReady(const T &seed)
 {
@@ -125,8 +145,14 @@ void xmrig::RxQueue::backgroundInit()
     while (m_state != STATE_SHUTDOWN) {
         std::unique_lock<std::mutex> lock(m_mutex);
 
-        if (m_state == STATE_IDLE) {
-            m_cv.wait(lock, [this]{ return m_state != STATE_IDLE; });
+        // While idle, periodically try to back small page dataset segments with huge pages.
+        if (m_state == STATE_IDLE && !m_cv.wait_for(lock, std::chrono::seconds(kUpgradeInterval), [this]{ return m_state != STATE_IDLE; })) {
+            if (m_storage) {
+                lock.unlock();
+                upgradeHugePages();
+            }
+
+            continue;
         }
 
         if (m_state != STATE_PENDING) {
@@ -148,6 +174,14 @@ void xmrig::RxQueue::backgroundInit()
 
         m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
 
+        // A dataset from the previous process is restored during init() if it fits, in any other case (light mode,
+        // failed allocation, other seed) the memory file is not needed anymore.
+        RxHandover::release();
+
+        if (RxTuner::isPending(item.seed.algorithm())) {
+            RxTuner::run(m_storage, item.seed, item.threads, item.priority);
+        }
+
         lock.lock();
 
         if (m_state == STATE_SHUTDOWN || !m_queue.empty()) {
@@ -174,6 +208,26 @@ void xmrig::RxQueue::onReady()
 }
 
 
+void xmrig::RxQueue::upgradeHugePages()
+{
+    const auto before = m_storage->hugePages();
+    if (before.total == 0 || before.isFullyAllocated() || !m_storage->upgradeHugePages()) {
+        return;
+    }
+
+    const auto after = m_storage->hugePages();
+
+    LOG_INFO("%s" GREEN_BOLD("dataset huge pages ") "%s%1.0f%% %u/%u" CLEAR BLACK_BOLD(" (was %1.0f%%)"),
+             Tags::randomx(),
+             (after.isFullyAllocated() ? GREEN_BOLD_S : YELLOW_BOLD_S),
+             after.percent(),
+             after.allocated,
+             after.total,
+             before.percent()
+             );
+}
+
+
 namespace xmrig {
 
 
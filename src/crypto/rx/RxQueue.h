@@ -74,6 +74,7 @@ public:
     RxQueue(IRxListener *listener);
     ~RxQueue() override;
 
+    bool handover();
     HugePagesInfo hugePages();
     RxDataset *dataset(const Job &job, uint32_t nodeId);
     template<typename T> bool isReady(const T &seed);
@@ -83,6 +84,8 @@ protected:
     inline void onAsync() override  { onReady(); }
 
 private:
+    constexpr static int kUpgradeInterval = 60;
+
     enum State {
         STATE_IDLE,
         STATE_PENDING,
@@ -92,6 +95,7 @@ private:
     template<typename T> bool isReadyUnsafe(const T &seed) const;
     void backgroundInit();
     void onReady();
+    void upgradeHugePages();
 
     IRxListener *m_listener = nullptr;
     IRxStorage *m_storage   = nullptr;
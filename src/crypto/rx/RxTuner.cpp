@@ -0,0 +1,443 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxTuner.h"
+#include "3rdparty/fmt/core.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/interfaces/IRxStorage.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuThread.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
+#include "base/kernel/Process.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "crypto/common/Assembly.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+#include "crypto/rx/RxVm.h"
+#include "version.h"
+
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+static const char *kFileName                = "rx-tune.json";
+static const char *kHashrate                = "hashrate";
+static const char *kInitTime                = "init-time";
+static constexpr uint64_t kWarmupTime       = 500;
+static constexpr uint64_t kTrialTime        = 3000;
+static constexpr uint32_t kInitItems        = 20000;    // per thread, must be a multiple of 5 for the AVX2 code path
+
+
+struct RxTunerProfile
+{
+    double hashrate[RxConfig::ScratchpadPrefetchMax] = {};
+    int initAVX2                                     = -1;
+    int scratchpadPrefetchMode                       = RxConfig::ScratchpadPrefetchT0;
+    uint64_t initTime[2]                             = {};
+};
+
+
+struct RxTunerTask
+{
+    Algorithm algorithm;
+    Assembly assembly;
+    bool hugePages  = false;
+    bool softAes    = false;
+    std::vector<int64_t> affinities;
+};
+
+
+static bool loaded = false;
+static RxTunerTask pending;
+static std::map<std::string, RxTunerProfile> profiles;
+static std::mutex mutex;
+static std::set<std::string> attempted;
+static std::string active;
+
+
+static std::string profileKey(const Algorithm &algorithm)
+{
+    const auto cpu = Cpu::info();
+
+    return fmt::format("{} {}C/{}T {}N {}G {} {}",
+                       cpu->brand(),
+                       cpu->cores(),
+                       cpu->threads(),
+                       cpu->nodes(),
+                       uv_get_total_memory() >> 30,
+                       algorithm.name(),
+                       APP_VERSION
+                       );
+}
+
+
+static void load()
+{
+    if (loaded) {
+        return;
+    }
+
+    loaded = true;
+
+    rapidjson::Document doc;
+    if (!Json::get(Process::location(Process::DataLocation, kFileName), doc) || !doc.IsObject()) {
+        return;
+    }
+
+    for (const auto &kv : doc.GetObject()) {
+        if (!kv.value.IsObject()) {
+            continue;
+        }
+
+        RxTunerProfile profile;
+        profile.initAVX2               = Json::getInt(kv.value, RxConfig::kInitAVX2, profile.initAVX2);
+        profile.scratchpadPrefetchMode = Json::getInt(kv.value, RxConfig::kScratchpadPrefetchMode, profile.scratchpadPrefetchMode);
+
+        const auto &hashrate = Json::getArray(kv.value, kHashrate);
+        for (rapidjson::SizeType i = 0; i < hashrate.Size() && i < RxConfig::ScratchpadPrefetchMax; ++i) {
+            profile.hashrate[i] = hashrate[i].IsNumber() ? hashrate[i].GetDouble() : 0.0;
+        }
+
+        const auto &initTime = Json::getArray(kv.value, kInitTime);
+        for (rapidjson::SizeType i = 0; i < initTime.Size() && i < 2; ++i) {
+            profile.initTime[i] = initTime[i].IsUint64() ? initTime[i].GetUint64() : 0;
+        }
+
+        if (profile.scratchpadPrefetchMode >= 0 && profile.scratchpadPrefetchMode < static_cast<int>(RxConfig::ScratchpadPrefetchMax)) {
+            profiles[kv.name.GetString()] = profile;
+        }
+    }
+}
+
+
+static rapidjson::Value profileToJSON(const RxTunerProfile &profile, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+    obj.AddMember(StringRef(RxConfig::kScratchpadPrefetchMode),  profile.scratchpadPrefetchMode, allocator);
+    obj.AddMember(StringRef(RxConfig::kInitAVX2),                profile.initAVX2, allocator);
+
+    Value hashrate(kArrayType);
+    for (double value : profile.hashrate) {
+        hashrate.PushBack(Json::normalize(value, true), allocator);
+    }
+
+    Value initTime(kArrayType);
+    for (uint64_t value : profile.initTime) {
+        initTime.PushBack(value, allocator);
+    }
+
+    obj.AddMember(StringRef(kHashrate), hashrate, allocator);
+    obj.AddMember(StringRef(kInitTime), initTime, allocator);
+
+    return obj;
+}
+
+
+static void save()
+{
+    using namespace rapidjson;
+
+    Document doc(kObjectType);
+    for (const auto &kv : profiles) {
+        doc.AddMember(Value(kv.first.c_str(), doc.GetAllocator()), profileToJSON(kv.second, doc), doc.GetAllocator());
+    }
+
+    if (!Json::save(Process::location(Process::DataLocation, kFileName), doc)) {
+        LOG_ERR("%s " RED("failed to save tuning results to \"%s\""), Tags::randomx(), kFileName);
+    }
+}
+
+
+static void hashThread(IRxStorage *storage, const Job *job, const RxTunerTask *task, int64_t affinity, int priority, std::atomic<uint64_t> *total)
+{
+    const uint32_t node = VirtualMemory::bindToNUMANode(affinity);
+
+    Platform::trySetThreadAffinity(affinity);
+    Platform::setThreadPriority(priority);
+
+    auto dataset = storage->dataset(*job, node);
+    if (!dataset) {
+        return;
+    }
+
+    VirtualMemory memory(job->algorithm().l3(), task->hugePages, false, false, node);
+    auto vm = RxVm::create(dataset, memory.scratchpad(), task->softAes, task->assembly, node);
+
+    alignas(16) uint8_t blob[76] = {};
+    uint8_t hash[32]             = {};
+    uint32_t nonce               = static_cast<uint32_t>(affinity) << 24;
+    uint64_t count               = 0;
+
+    const uint64_t start = Chrono::steadyMSecs() + kWarmupTime;
+    const uint64_t end   = start + kTrialTime;
+    uint64_t now         = 0;
+
+    while ((now = Chrono::steadyMSecs()) < end) {
+        memcpy(blob + 39, &nonce, sizeof(nonce));
+        randomx_calculate_hash(vm, blob, sizeof(blob), hash);
+
+        ++nonce;
+
+        if (now >= start) {
+            ++count;
+        }
+    }
+
+    RxVm::destroy(vm);
+
+    total->fetch_add(count);
+}
+
+
+static double measureHashrate(IRxStorage *storage, const Job &job, const RxTunerTask &task, int priority)
+{
+    std::atomic<uint64_t> total{ 0 };
+    std::vector<std::thread> threads;
+    threads.reserve(task.affinities.size());
+
+    for (int64_t affinity : task.affinities) {
+        threads.emplace_back(hashThread, storage, &job, &task, affinity, priority, &total);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    return total.load() * 1000.0 / kTrialTime;
+}
+
+
+static uint64_t measureInit(RxDataset *dataset, const RxSeed &seed, bool hugePages, uint32_t threads, int priority, int initAVX2)
+{
+    randomx_set_optimized_dataset_init(initAVX2);
+
+    RxCache cache(hugePages, 0);
+    if (!cache.get() || !cache.isJIT()) {
+        return 0;
+    }
+
+    cache.init(seed.data());
+
+    const uint64_t count = std::min<uint64_t>(static_cast<uint64_t>(kInitItems) * threads, randomx_dataset_item_count());
+    const uint64_t ts    = Chrono::steadyMSecs();
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    // Values written here are identical to the ones computed by the regular dataset init.
+    for (uint32_t i = 0; i < threads; ++i) {
+        const uint64_t a = (count * i) / threads;
+        const uint64_t b = (count * (i + 1)) / threads;
+
+        workers.emplace_back([&cache, dataset, a, b, priority]() {
+            Platform::setThreadPriority(priority);
+            randomx_init_dataset(dataset->get(), cache.get(), a, b - a);
+        });
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    return std::max<uint64_t>(Chrono::steadyMSecs() - ts, 1);
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxTuner::apply(const Algorithm &algorithm)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    load();
+
+    const auto key = profileKey(algorithm);
+    const auto it  = profiles.find(key);
+    if (it == profiles.end()) {
+        return false;
+    }
+
+    randomx_set_scratchpad_prefetch_mode(it->second.scratchpadPrefetchMode);
+    randomx_set_optimized_dataset_init(it->second.initAVX2);
+
+    if (active != key) {
+        active = key;
+
+        LOG_INFO("%s " GREEN_BOLD("use tuned settings") " scratchpad_prefetch_mode " CYAN_BOLD("%d") " init-avx2 " CYAN_BOLD("%d"),
+                 Tags::randomx(), it->second.scratchpadPrefetchMode, it->second.initAVX2);
+    }
+
+    return true;
+}
+
+
+bool xmrig::RxTuner::isPending(const Algorithm &algorithm)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return !pending.affinities.empty() && pending.algorithm == algorithm;
+}
+
+
+rapidjson::Value xmrig::RxTuner::toJSON(rapidjson::Document &doc)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = profiles.find(active);
+    if (active.empty() || it == profiles.end()) {
+        return rapidjson::Value(rapidjson::kNullType);
+    }
+
+    auto obj = profileToJSON(it->second, doc);
+    obj.AddMember("key", rapidjson::Value(active.c_str(), doc.GetAllocator()), doc.GetAllocator());
+
+    return obj;
+}
+
+
+void xmrig::RxTuner::run(IRxStorage *storage, const RxSeed &seed, uint32_t initThreads, int priority)
+{
+    const Algorithm algorithm = seed.algorithm();
+    RxTunerTask current;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.affinities.empty() || pending.algorithm != algorithm) {
+            return;
+        }
+
+        current = pending;
+    }
+
+    Job job(false, algorithm, String());
+    job.setSeedHash(Cvt::toHex(seed.data()).data());
+
+    RxDataset *dataset = storage->dataset(job, 0);
+    if (!dataset) {
+        return;
+    }
+
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    LOG_INFO("%s " MAGENTA_BOLD("tuning runtime settings") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%zu") WHITE_BOLD(" threads)"),
+             Tags::randomx(), algorithm.name(), current.affinities.size());
+
+    RxTunerProfile profile;
+    double best = 0.0;
+
+#   if defined(XMRIG_FEATURE_ASM) && (defined(_M_X64) || defined(__x86_64__))
+    constexpr int maxPrefetchMode = RxConfig::ScratchpadPrefetchMax;
+#   else
+    constexpr int maxPrefetchMode = RxConfig::ScratchpadPrefetchT0 + 1; // prefetch mode only affects x86 JIT code
+#   endif
+
+    for (int mode = RxConfig::ScratchpadPrefetchOff; mode < maxPrefetchMode; ++mode) {
+        randomx_set_scratchpad_prefetch_mode(mode);
+        RxAlgo::apply(algorithm);
+
+        profile.hashrate[mode] = measureHashrate(storage, job, current, priority);
+
+        LOG_INFO("%s scratchpad_prefetch_mode " CYAN_BOLD("%d") " " CYAN_BOLD("%.1f H/s"), Tags::randomx(), mode, profile.hashrate[mode]);
+
+        if (profile.hashrate[mode] > best) {
+            best                           = profile.hashrate[mode];
+            profile.scratchpadPrefetchMode = mode;
+        }
+    }
+
+    randomx_set_scratchpad_prefetch_mode(profile.scratchpadPrefetchMode);
+    RxAlgo::apply(algorithm);
+
+    if (dataset->get() && Cpu::info()->hasAVX2()) {
+        for (int initAVX2 = 0; initAVX2 < 2; ++initAVX2) {
+            profile.initTime[initAVX2] = measureInit(dataset, seed, current.hugePages, initThreads, priority, initAVX2);
+
+            LOG_INFO("%s init-avx2 " CYAN_BOLD("%d") " " CYAN_BOLD("%" PRIu64 " ms") BLACK_BOLD(" (%u items)"),
+                     Tags::randomx(), initAVX2, profile.initTime[initAVX2], kInitItems * initThreads);
+        }
+
+        if (profile.initTime[0] && profile.initTime[1]) {
+            profile.initAVX2 = profile.initTime[1] < profile.initTime[0] ? 1 : 0;
+        }
+    }
+
+    randomx_set_optimized_dataset_init(profile.initAVX2);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto key = profileKey(algorithm);
+    attempted.insert(key);
+    pending = {};
+
+    if (best <= 0.0) {
+        LOG_WARN("%s " YELLOW_BOLD("tuning failed") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+        return;
+    }
+
+    profiles[key] = profile;
+    active        = key;
+
+    save();
+
+    LOG_INFO("%s " GREEN_BOLD("tuning done") " scratchpad_prefetch_mode " CYAN_BOLD("%d") " init-avx2 " CYAN_BOLD("%d") BLACK_BOLD(" (%" PRIu64 " ms)"),
+             Tags::randomx(), profile.scratchpadPrefetchMode, profile.initAVX2, Chrono::steadyMSecs() - ts);
+}
+
+
+void xmrig::RxTuner::schedule(const Algorithm &algorithm, const std::vector<CpuThread> &threads, bool softAes, const Assembly &assembly, bool hugePages)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (threads.empty() || attempted.count(profileKey(algorithm))) {
+        return;
+    }
+
+    pending.algorithm = algorithm;
+    pending.assembly  = assembly;
+    pending.hugePages = hugePages;
+    pending.softAes   = softAes;
+
+    pending.affinities.clear();
+    for (const auto &thread : threads) {
+        pending.affinities.emplace_back(thread.affinity());
+    }
+}
@@ -0,0 +1,64 @@
+/* XMRig
+ * Copyright (c) 2018-2023 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2023 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RXTUNER_H
+#define XMRIG_RXTUNER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+class Algorithm;
+class Assembly;
+class CpuThread;
+class IRxStorage;
+class RxSeed;
+
+
+/**
+ * Measured selection of RandomX runtime knobs.
+ *
+ * Short trials run on the background dataset thread right after the first dataset is ready,
+ * before any worker starts. Only knobs that can be switched without reallocating the dataset
+ * are trialled: scratchpad prefetch mode (hashrate) and AVX2 dataset init (init time).
+ * Results are stored in "rx-tune.json" in the data directory, keyed by CPU, memory layout,
+ * algorithm and miner version, and applied automatically on later starts.
+ */
+class RxTuner
+{
+public:
+    static bool apply(const Algorithm &algorithm);
+    static bool isPending(const Algorithm &algorithm);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void run(IRxStorage *storage, const RxSeed &seed, uint32_t initThreads, int priority);
+    static void schedule(const Algorithm &algorithm, const std::vector<CpuThread> &threads, bool softAes, const Assembly &assembly, bool hugePages);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RXTUNER_H */
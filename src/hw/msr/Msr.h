@@ -51,6 +51,7 @@ public:
     inline bool write(const MsrItem &item, int32_t cpu = -1, bool verbose = true)   { return write(item.reg(), item.value(), cpu, item.mask(), verbose); }
 
     bool isAvailable() const;
+    bool write(const MsrItems &items, int32_t cpu = -1, bool verbose = true);
     bool write(uint32_t reg, uint64_t value, int32_t cpu = -1, uint64_t mask = MsrItem::kNoMask, bool verbose = true);
     bool write(Callback &&callback);
     MsrItem read(uint32_t reg, int32_t cpu = -1, bool verbose = true) const;
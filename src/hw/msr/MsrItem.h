@@ -41,10 +41,14 @@ public:
 
     MsrItem(const rapidjson::Value &value);
 
-    inline bool isValid() const     { return m_reg > 0; }
-    inline uint32_t reg() const     { return m_reg; }
-    inline uint64_t value() const   { return m_value; }
-    inline uint64_t mask() const    { return m_mask; }
+    inline bool isEqual(const MsrItem &other) const     { return m_reg == other.m_reg && m_value == other.m_value && m_mask == other.m_mask; }
+    inline bool isValid() const                         { return m_reg > 0; }
+    inline uint32_t reg() const                         { return m_reg; }
+    inline uint64_t value() const                       { return m_value; }
+    inline uint64_t mask() const                        { return m_mask; }
+
+    inline bool operator!=(const MsrItem &other) const  { return !isEqual(other); }
+    inline bool operator==(const MsrItem &other) const  { return isEqual(other); }
 
     static inline uint64_t maskedValue(uint64_t old_value, uint64_t new_value, uint64_t mask)
     {
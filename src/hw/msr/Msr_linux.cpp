@@ -23,21 +23,28 @@
 #include "base/io/log/Log.h"
 
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cinttypes>
 #include <cstdio>
+#include <cstdlib>
 #include <dirent.h>
 #include <fcntl.h>
 #include <fstream>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
 
 
 namespace xmrig {
 
 
+constexpr size_t kMaxWriters = 16;
+
+
 static int msr_open(int32_t cpu, int flags)
 {
     const auto name = fmt::format("/dev/cpu/{}/msr", cpu < 0 ? Cpu::info()->units().front() : cpu);
@@ -96,17 +103,70 @@ bool xmrig::Msr::isAvailable() const
 }
 
 
+bool xmrig::Msr::write(const MsrItems &items, int32_t cpu, bool verbose)
+{
+    const int fd = msr_open(cpu, O_RDWR);
+    bool success = fd >= 0;
+
+    for (const auto &item : items) {
+        uint64_t value = item.value();
+
+        if (success && item.mask() != MsrItem::kNoMask) {
+            uint64_t old_value = 0;
+            if (pread(fd, &old_value, sizeof old_value, item.reg()) == sizeof old_value) {
+                value = MsrItem::maskedValue(old_value, value, item.mask());
+            }
+        }
+
+        success = success && pwrite(fd, &value, sizeof value, item.reg()) == sizeof value;
+
+        if (!success) {
+            if (verbose) {
+                LOG_WARN("%s " YELLOW_BOLD("cannot set MSR 0x%08" PRIx32 " to 0x%016" PRIx64), tag(), item.reg(), value);
+            }
+
+            break;
+        }
+    }
+
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    return success;
+}
+
+
 bool xmrig::Msr::write(Callback &&callback)
 {
     const auto &units = Cpu::info()->units();
 
-    for (int32_t pu : units) {
-        if (!callback(pu)) {
-            return false;
-        }
+    // Every MSR access is an IPI to the target CPU and the kernel waits for it, so the cores are written in parallel.
+    const size_t count = std::min(units.size(), kMaxWriters);
+    if (count <= 1) {
+        return std::all_of(units.begin(), units.end(), [&callback](int32_t pu) { return callback(pu); });
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> success(true);
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back([&callback, &units, &next, &success]() {
+            for (size_t i = next++; i < units.size() && success; i = next++) {
+                if (!callback(units[i])) {
+                    success = false;
+                }
+            }
+        });
     }
 
-    return true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    return success;
 }
 
 
@@ -206,6 +206,18 @@ bool xmrig::Msr::isAvailable() const
 }
 
 
+bool xmrig::Msr::write(const MsrItems &items, int32_t cpu, bool verbose)
+{
+    for (const auto &item : items) {
+        if (!write(item, cpu, verbose)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 bool xmrig::Msr::write(Callback &&callback)
 {
     const auto &units = Cpu::info()->units();
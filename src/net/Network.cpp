@@ -23,6 +23,8 @@
 
 #include "net/Network.h"
 #include "3rdparty/rapidjson/document.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
@@ -34,6 +36,7 @@
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "core/Miner.h"
+#include "crypto/common/Nonce.h"
 #include "net/JobResult.h"
 #include "net/JobResults.h"
 #include "net/strategies/DonateStrategy.h"
@@ -55,6 +58,7 @@
 #include <ctime>
 #include <iterator>
 #include <memory>
+#include <uv.h>
 
 
 xmrig::Network::Network(Controller *controller) :
@@ -76,7 +80,8 @@ xmrig::Network::Network(Controller *controller) :
         m_donate = new DonateStrategy(controller, this);
     }
 
-    m_timer = new Timer(this, kTickInterval, kTickInterval);
+    m_timer   = new Timer(this, kTickInterval, kTickInterval);
+    m_tickDue = uv_hrtime() / 1000 + kTickInterval * 1000;
 }
 
 
@@ -236,6 +241,10 @@ void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult
         LOG_INFO("%s " GREEN_BOLD("accepted") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " BLACK_BOLD("(%" PRIu64 " ms)"),
                  backend_tag(result.backend), m_state->accepted(), m_state->rejected(), diff, scale, result.elapsed);
     }
+
+#   ifdef XMRIG_FEATURE_API
+    m_controller->api()->invalidate();
+#   endif
 }
 
 
@@ -262,8 +271,60 @@ void xmrig::Network::onRequest(IApiRequest &request)
 #endif
 
 
+void xmrig::Network::predictExhaustion(IClient *client)
+{
+    const Job job = m_controller->miner()->job();
+    if (!client || job.index() != 0 || !job.isValid() || client->job().id() != job.id() || (m_requestedJob.id() == job.id() && m_requestedJob.isEqualBlob(job))) {
+        return;
+    }
+
+    double hashrate = 0.0;
+
+    for (IBackend *backend : m_controller->miner()->backends()) {
+        const Hashrate *hr = backend->hashrate();
+
+        if (backend->isEnabled() && hr) {
+            hashrate += hr->calc(Hashrate::ShortInterval);
+        }
+    }
+
+    if (hashrate <= 0.0) {
+        return;
+    }
+
+    // Small nonce masks (NiceHash) run out in minutes, a new job must arrive before the workers pause.
+    const uint64_t mask = job.nonceMask() & 0x7FFFFFFFFFFFFFFFULL;
+    const uint64_t used = Nonce::counter(0);
+    const double left   = used < mask ? static_cast<double>(mask - used) * 1000.0 / hashrate : 0.0;
+
+    if (left > static_cast<double>(kNonceLead + client->rtt() * 2)) {
+        return;
+    }
+
+    m_requestedJob = job;
+
+    if (client->requestJob()) {
+        LOG_INFO("%s " YELLOW("nonce space runs out in ") YELLOW_BOLD("%.1f s") YELLOW(", request a new job"), Tags::network(), left / 1000.0);
+    }
+}
+
+
 void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
 {
+    // Zero when the job was not delivered from a network read (benchmark), no sample is taken then.
+    const uint64_t received = BaseClient::readTime();
+
+    if (!donate && m_donate) {
+        static_cast<DonateStrategy *>(m_donate)->update(client, job);
+    }
+
+    // Workers get the job first, the log line below and the API refresh are not on the critical path.
+    m_controller->miner()->setJob(job, donate);
+
+    if (received) {
+        m_state->addJobLatency((uv_hrtime() - received) / 1000);
+    }
+
 #   ifdef XMRIG_FEATURE_BENCHMARK
     if (!BenchState::size())
 #   endif
@@ -291,11 +352,9 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
                  Tags::network(), client->pool().host().data(), client->pool().port(), zmq_buf, diff, scale, job.algorithm().name(), height_buf, tx_buf);
     }
 
-    if (!donate && m_donate) {
-        static_cast<DonateStrategy *>(m_donate)->update(client, job);
-    }
-
-    m_controller->miner()->setJob(job, donate);
+#   ifdef XMRIG_FEATURE_API
+    m_controller->api()->invalidate();
+#   endif
 }
 
 
@@ -303,7 +362,17 @@ void xmrig::Network::tick()
 {
     const uint64_t now = Chrono::steadyMSecs();
 
+    // How late the event loop thread woke up for this timer, it shows how long the thread waits for a CPU while hashing threads are busy.
+    // The repeating timer is armed again right before this callback, both times are uv_hrtime() in microseconds.
+    const uint64_t wakeup = uv_hrtime() / 1000;
+    m_state->addWakeupLatency(wakeup > m_tickDue ? wakeup - m_tickDue : 0);
+
+    m_tickDue = wakeup + kTickInterval * 1000;
+
     m_strategy->tick(now);
+    m_state->setRtt(m_strategy->client()->rtt());
+
+    predictExhaustion(m_strategy->client());
 
     if (m_donate) {
         m_donate->tick(now);
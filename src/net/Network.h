@@ -26,6 +26,7 @@
 #include "base/kernel/interfaces/IBaseListener.h"
 #include "base/kernel/interfaces/IStrategyListener.h"
 #include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/stratum/Job.h"
 #include "base/tools/Object.h"
 #include "interfaces/IJobResultListener.h"
 
@@ -49,7 +50,8 @@ public:
     Network(Controller *controller);
     ~Network() override;
 
-    inline IStrategy *strategy() const { return m_strategy; }
+    inline const NetworkState *state() const    { return m_state; }
+    inline IStrategy *strategy() const          { return m_strategy; }
 
     void connect();
     void execCommand(char command);
@@ -71,8 +73,10 @@ protected:
 #   endif
 
 private:
-    constexpr static int kTickInterval = 1 * 1000;
+    constexpr static int kTickInterval      = 1 * 1000;
+    constexpr static uint64_t kNonceLead    = 5 * 1000;
 
+    void predictExhaustion(IClient *client);
     void setJob(IClient *client, const Job &job, bool donate);
     void tick();
 
@@ -83,9 +87,11 @@ private:
 
     Controller *m_controller;
     IStrategy *m_donate     = nullptr;
+    Job m_requestedJob;
     IStrategy *m_strategy   = nullptr;
     NetworkState *m_state   = nullptr;
     Timer *m_timer          = nullptr;
+    uint64_t m_tickDue      = 0;
 };
 
 